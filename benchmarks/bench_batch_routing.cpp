@@ -0,0 +1,101 @@
+#include "../include/algorithms/Graph.hpp"
+#include "../include/algorithms/DijkstraRouter.hpp"
+#include "../include/utils/Simulation.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <string>
+
+// Batch routing throughput on a ~50k-room campus, by worker thread count.
+// Each row is the best of a few batches on one router, as across shift
+// changes: its workers and search spaces are already in place.
+// Usage: bench_batch_routing.exe [queries]
+
+static const int BATCHES = 3;
+
+static std::string gridNode(int r, int c) {
+    return "N_" + std::to_string(r) + "_" + std::to_string(c);
+}
+
+int main(int argc, char* argv[]) {
+    int queryCount = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    const int side = 224;       // 50,176 rooms
+    
+    Graph layout;
+    Simulation::generateCampusLayout(layout, side, side);
+    layout.getCompactView();
+    
+    std::srand(7);
+    std::vector<std::pair<LocationId, LocationId>> queries;
+    for (int i = 0; i < queryCount; i++) {
+        queries.push_back(std::make_pair(gridNode(std::rand() % side, std::rand() % side),
+                                         gridNode(std::rand() % side, std::rand() % side)));
+    }
+    
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned> threadCounts;
+    for (unsigned t = 1; t <= std::max(4u, hardware); t *= 2) {
+        threadCounts.push_back(t);
+    }
+    if (threadCounts.back() != hardware && hardware > 4) {
+        threadCounts.push_back(hardware);
+    }
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              BATCH ROUTING THROUGHPUT                              ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Rooms: " << std::setw(8) << side * side << "   Queries: " << std::setw(6) << queryCount
+              << "   Hardware threads: " << std::setw(4) << hardware << "         ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Threads     Total (ms)     Queries/s      Speedup                  ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    double baselineMillis = 0.0;
+    double baselineChecksum = 0.0;
+    for (unsigned threads : threadCounts) {
+        DijkstraRouter router(&layout);
+        router.setRouteCacheCapacity(0);
+        router.setBatchThreadCount(threads);
+        
+        std::vector<RouteInfo> routes;
+        double millis = 0.0;
+        for (int batch = 0; batch < BATCHES; batch++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            routes = router.findShortestPathsBatch(queries);
+            auto end = std::chrono::high_resolution_clock::now();
+            double batchMillis = std::chrono::duration<double, std::milli>(end - start).count();
+            if (batch == 0 || batchMillis < millis) millis = batchMillis;
+        }
+        
+        double checksum = 0.0;
+        for (const RouteInfo& route : routes) {
+            checksum += route.totalDistance;
+        }
+        if (threads == 1) {
+            baselineMillis = millis;
+            baselineChecksum = checksum;
+        }
+        
+        std::cout << "║ " << std::setw(7) << threads
+                  << std::setw(15) << std::fixed << std::setprecision(1) << millis
+                  << std::setw(14) << std::setprecision(0) << queryCount / (millis / 1000.0)
+                  << std::setw(11) << std::setprecision(2) << baselineMillis / millis << "x"
+                  << (threads > hardware ? " (oversub.)" : "           ")
+                  << (checksum == baselineChecksum ? "        " : "MISMATCH") << "║\n";
+    }
+    
+    if (hardware < 2) {
+        std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+        std::cout << "║ One hardware thread: multi-core scaling is NOT measured on this    ║\n";
+        std::cout << "║ machine. Rows above 1 only show the cost of the extra workers.     ║\n";
+    } else if (hardware < 4) {
+        std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+        std::cout << "║ Scaling is only measured up to " << std::setw(2) << hardware
+                  << " hardware threads here.           ║\n";
+    }
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
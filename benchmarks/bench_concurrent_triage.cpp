@@ -0,0 +1,124 @@
+#include "../include/data_structures/ConcurrentTriageQueue.hpp"
+#include "../include/data_structures/TriageQueue.hpp"
+#include "../include/core/Patient.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+// Parallel intake throughput: P producer desks push a fixed surge while
+// C consumers drain it. MultiQueue vs one TriageQueue behind a mutex.
+// Usage: bench_concurrent_triage.exe [patients] [consumers]
+
+static std::vector<Patient> makeSurge(int count) {
+    std::srand(23);
+    std::vector<Patient> patients;
+    patients.reserve(count);
+    for (int i = 0; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = 40 + std::rand() % 100;
+        vitals.bloodPressure = 70 + std::rand() % 110;
+        vitals.oxygenLevel = 80 + std::rand() % 20;
+        vitals.temperature = 35.0 + (std::rand() % 60) / 10.0;
+        patients.push_back(Patient("P" + std::to_string(i), vitals, "ER"));
+    }
+    return patients;
+}
+
+// Baseline: the single-threaded queue made safe with one global lock
+class LockedTriageQueue {
+private:
+    std::mutex lock;
+    TriageQueue queue;
+    
+public:
+    LockedTriageQueue() { queue.setVerbose(false); }
+    
+    void addPatient(const Patient& patient) {
+        std::lock_guard<std::mutex> guard(lock);
+        queue.addPatient(patient);
+    }
+    bool tryGetNextPatient(Patient& patient) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (queue.isEmpty()) return false;
+        patient = queue.getNextPatient();
+        return true;
+    }
+};
+
+// Runs the surge through the queue; returns wall-clock milliseconds
+template<typename Queue>
+static double runIntake(Queue& queue, const std::vector<Patient>& surge,
+                        int producers, int consumers) {
+    std::atomic<int> served(0);
+    int total = static_cast<int>(surge.size());
+    std::vector<std::thread> threads;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&queue, &surge, p, producers]() {
+            for (size_t i = p; i < surge.size(); i += producers) {
+                queue.addPatient(surge[i]);
+            }
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&queue, &served, total]() {
+            Patient patient;
+            while (served.load(std::memory_order_relaxed) < total) {
+                if (queue.tryGetNextPatient(patient)) {
+                    served.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int patientCount = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    int consumers = (argc > 2) ? std::atoi(argv[2]) : 4;
+    std::vector<Patient> surge = makeSurge(patientCount);
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              CONCURRENT TRIAGE INTAKE THROUGHPUT                   ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Patients: " << std::setw(8) << patientCount << "   Consumers: " << std::setw(3)
+              << consumers << "   Hardware threads: " << std::setw(4) << hardware << "       ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Producers   Mutex queue (ops/s)   MultiQueue (ops/s)   Speedup     ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    for (int producers = 1; producers <= 32; producers *= 2) {
+        LockedTriageQueue locked;
+        double lockedMillis = runIntake(locked, surge, producers, consumers);
+        
+        ConcurrentTriageQueue multi;
+        double multiMillis = runIntake(multi, surge, producers, consumers);
+        
+        // One add plus one extraction per patient
+        double lockedRate = 2.0 * patientCount / (lockedMillis / 1000.0);
+        double multiRate = 2.0 * patientCount / (multiMillis / 1000.0);
+        std::cout << "║ " << std::setw(9) << producers
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(22) << lockedRate << std::setw(21) << multiRate
+                  << std::setprecision(2) << std::setw(10) << multiRate / lockedRate << "x"
+                  << "    ║\n";
+    }
+    
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
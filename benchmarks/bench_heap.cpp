@@ -0,0 +1,72 @@
+#include "../include/data_structures/MinHeap.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <random>
+
+// Insert / extractMin throughput of MinHeap by arity.
+// Usage: bench_heap.exe [maxElements]
+
+struct PhaseTimes {
+    double insertNanos;
+    double extractNanos;
+    long long checksum;
+};
+
+template<unsigned Arity>
+static PhaseTimes runHeap(const std::vector<int>& keys) {
+    MinHeap<int, Arity> heap;
+    heap.reserve(keys.size());
+    PhaseTimes times;
+    times.checksum = 0;
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int key : keys) {
+        heap.insert(key);
+    }
+    auto middle = std::chrono::high_resolution_clock::now();
+    
+    // Checksum of the order keeps the extractions from being optimised out
+    long long position = 0;
+    while (!heap.isEmpty()) {
+        times.checksum += heap.extractMin() * (++position & 7);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    
+    times.insertNanos = std::chrono::duration<double, std::nano>(middle - start).count() / keys.size();
+    times.extractNanos = std::chrono::duration<double, std::nano>(end - middle).count() / keys.size();
+    return times;
+}
+
+int main(int argc, char* argv[]) {
+    long long maxElements = (argc > 1) ? std::atoll(argv[1]) : 10000000;
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              MIN-HEAP ARITY BENCHMARK (int keys)                   ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Elements    Arity   Insert (ns/op)   Extract (ns/op)               ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    std::mt19937 rng(42);
+    for (long long n = 10000; n <= maxElements; n *= 10) {
+        std::vector<int> keys(n);
+        for (int& key : keys) {
+            key = static_cast<int>(rng() & 0x7FFFFFFF);
+        }
+        
+        PhaseTimes results[3] = {runHeap<2>(keys), runHeap<4>(keys), runHeap<8>(keys)};
+        const unsigned arities[3] = {2, 4, 8};
+        for (int a = 0; a < 3; a++) {
+            std::cout << "║ " << std::setw(8) << n << std::setw(9) << arities[a]
+                      << std::setw(17) << std::fixed << std::setprecision(1) << results[a].insertNanos
+                      << std::setw(18) << results[a].extractNanos
+                      << (results[a].checksum == results[0].checksum ? "               " : "      MISMATCH ")
+                      << "║\n";
+        }
+    }
+    
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
@@ -0,0 +1,213 @@
+#include "../include/core/EmergencyResponseSystem.hpp"
+#include "../include/utils/WriteAheadLog.hpp"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Durability costs: journal append overhead under sustained load, how long
+// a restart takes to replay a large journal, and snapshot write and
+// cold-start load times.
+// Usage: bench_persistence.exe [operations] [snapshot patients]
+
+static const char* JOURNAL_PATH = "bench_persistence.wal";
+static const char* SNAPSHOT_PATH = "bench_persistence.snap";
+static const char* FULL_JOURNAL_PATH = "bench_persistence_full.wal";     // kept from before the snapshot trims it
+
+static std::vector<Patient> makeArrivals(int count) {
+    std::srand(29);
+    std::vector<Patient> patients;
+    patients.reserve(count);
+    for (int i = 0; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = 40 + std::rand() % 100;
+        vitals.bloodPressure = 70 + std::rand() % 110;
+        vitals.oxygenLevel = 80 + std::rand() % 20;
+        vitals.temperature = 35.0 + (std::rand() % 60) / 10.0;
+        patients.push_back(Patient("P" + std::to_string(1000000 + i), vitals, "ER"));
+    }
+    return patients;
+}
+
+static double elapsedMillis(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static void printRow(const std::string& name, double millis, double perOpMicros) {
+    std::cout << "║ " << std::setw(38) << std::left << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(11) << millis
+              << std::setprecision(2) << std::setw(14) << perOpMicros << "    ║\n";
+}
+
+// 80% arrivals, 20% treatments: one journal record per operation
+static double runOperations(EmergencyResponseSystem& system, const std::vector<Patient>& arrivals) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < arrivals.size(); i++) {
+        system.registerNewPatient(arrivals[i]);
+        if (i % 4 == 3) system.processNextCriticalPatient();
+    }
+    system.syncJournal();
+    return elapsedMillis(start);
+}
+
+// Same state reached two ways on restart: load the snapshot and the
+// journal it trimmed, or replay the untrimmed journal of every
+// registration and treatment that built it
+static void runSnapshotBenchmark(int patientCount) {
+    std::vector<Patient> arrivals = makeArrivals(patientCount);
+    int treated = patientCount / 10;
+    double captureMillis, writeMillis, snapshotStartMillis, journalStartMillis;
+    size_t snapshotBytes;
+    int waiting;
+    
+    std::cout.setstate(std::ios::failbit);
+    std::remove(JOURNAL_PATH);
+    {
+        EmergencyResponseSystem system;
+        system.openJournal(JOURNAL_PATH);
+        for (const Patient& patient : arrivals) {
+            system.registerNewPatient(patient);
+        }
+        for (int i = 0; i < treated; i++) {
+            system.processNextCriticalPatient();
+        }
+        waiting = system.getPendingPatients();
+        system.syncJournal();
+        {
+            std::ifstream source(JOURNAL_PATH, std::ios::binary);
+            std::ofstream copy(FULL_JOURNAL_PATH, std::ios::binary | std::ios::trunc);
+            copy << source.rdbuf();
+        }
+        
+        // Intake pauses only for the in-memory capture
+        auto start = std::chrono::high_resolution_clock::now();
+        snapshotBytes = system.saveSnapshot(SNAPSHOT_PATH);
+        captureMillis = elapsedMillis(start);
+        start = std::chrono::high_resolution_clock::now();
+        system.waitForSnapshot();
+        writeMillis = elapsedMillis(start);
+    }
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        EmergencyResponseSystem system;
+        system.loadSnapshot(SNAPSHOT_PATH);
+        system.openJournal(JOURNAL_PATH);
+        snapshotStartMillis = elapsedMillis(start);
+    }
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        EmergencyResponseSystem system;
+        system.openJournal(FULL_JOURNAL_PATH);
+        journalStartMillis = elapsedMillis(start);
+    }
+    std::remove(JOURNAL_PATH);
+    std::remove(FULL_JOURNAL_PATH);
+    std::remove(SNAPSHOT_PATH);
+    std::cout.clear();
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              SNAPSHOT AND COLD START                               ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Patients: " << std::setw(8) << patientCount << " (" << std::setw(8) << waiting
+              << " waiting), snapshot " << std::fixed << std::setprecision(1) << std::setw(6)
+              << snapshotBytes / (1024.0 * 1024.0) << " MB          ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Run                                    Total (ms) Per patient (μs) ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    printRow("Snapshot capture (intake paused)", captureMillis, captureMillis * 1000.0 / patientCount);
+    printRow("Snapshot write + fsync (background)", writeMillis, writeMillis * 1000.0 / patientCount);
+    printRow("Cold start: snapshot + journal", snapshotStartMillis, snapshotStartMillis * 1000.0 / patientCount);
+    printRow("Cold start: replay whole journal", journalStartMillis, journalStartMillis * 1000.0 / patientCount);
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+}
+
+int main(int argc, char* argv[]) {
+    int operations = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    int arrivalCount = operations * 4 / 5;
+    std::vector<Patient> arrivals = makeArrivals(arrivalCount);
+    
+    double plainMillis, journaledMillis, recoveryMillis, syncEachMillis;
+    uint64_t rawCommits;
+    double rawMillis;
+    size_t replayed;
+    const int syncEachCount = 2000;
+    
+    // Per-operation console output would dominate; keep the timings clean
+    std::cout.setstate(std::ios::failbit);
+    std::remove(JOURNAL_PATH);
+    {
+        EmergencyResponseSystem system;
+        plainMillis = runOperations(system, arrivals);
+    }
+    {
+        EmergencyResponseSystem system;
+        system.openJournal(JOURNAL_PATH);
+        journaledMillis = runOperations(system, arrivals);
+    }
+    {
+        EmergencyResponseSystem system;
+        auto start = std::chrono::high_resolution_clock::now();
+        replayed = system.openJournal(JOURNAL_PATH);
+        recoveryMillis = elapsedMillis(start);
+    }
+    std::remove(JOURNAL_PATH);
+    
+    // The log alone: registration-sized records, group commit vs one fsync each
+    {
+        WriteAheadLog log(JOURNAL_PATH, 0);
+        RecordWriter record;
+        record.putString("P123456");
+        record.putString("ER");
+        record.putI32(88);
+        record.putI32(120);
+        record.putI32(97);
+        record.putDouble(37.2);
+        record.putI64(1700000000);
+        record.putU8(0);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < operations; i++) {
+            log.append(1, record);
+        }
+        log.sync();
+        rawMillis = elapsedMillis(start);
+        rawCommits = log.getCommitCount();
+        
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < syncEachCount; i++) {
+            log.append(1, record);
+            log.sync();
+        }
+        syncEachMillis = elapsedMillis(start);
+    }
+    std::remove(JOURNAL_PATH);
+    std::cout.clear();
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              JOURNALING AND RECOVERY                               ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Operations: " << std::setw(8) << operations
+              << " (80% registrations, 20% treatments)           ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Run                                    Total (ms)   Per op (μs)    ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    printRow("Operations, no journal", plainMillis, plainMillis * 1000.0 / operations);
+    printRow("Operations, journaled", journaledMillis, journaledMillis * 1000.0 / operations);
+    printRow("  journaling overhead", journaledMillis - plainMillis,
+             (journaledMillis - plainMillis) * 1000.0 / operations);
+    printRow("Recovery: replay " + std::to_string(replayed) + " records", recoveryMillis,
+             recoveryMillis * 1000.0 / replayed);
+    printRow("Log append, group commit", rawMillis, rawMillis * 1000.0 / operations);
+    printRow("Log append, fsync per record", syncEachMillis, syncEachMillis * 1000.0 / syncEachCount);
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Group commits for " << std::setw(8) << operations << " appends: "
+              << std::setw(8) << rawCommits << "                       ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    
+    runSnapshotBenchmark((argc > 2) ? std::atoi(argv[2]) : 500000);
+    return 0;
+}
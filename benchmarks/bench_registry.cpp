@@ -0,0 +1,140 @@
+#include "../include/data_structures/FlatHashMap.hpp"
+#include "../include/core/Patient.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <unordered_map>
+
+// Patient registry lookups and inserts: std::unordered_map against
+// FlatHashMap, keyed by PatientId with full Patient records as values.
+// Usage: bench_registry.exe [patients]
+
+// Counts heap allocations so the table can show what each insert costs
+static size_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    void* block = std::malloc(size ? size : 1);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+struct PhaseTimes {
+    double insertNanos;
+    double hitNanos;
+    double missNanos;
+    double eraseNanos;
+    double allocationsPerInsert;
+    long long checksum;
+};
+
+static double nanosPerOp(std::chrono::high_resolution_clock::time_point start,
+                         std::chrono::high_resolution_clock::time_point end, size_t ops) {
+    return std::chrono::duration<double, std::nano>(end - start).count() / ops;
+}
+
+template<typename Map>
+static PhaseTimes runRegistry(const std::vector<Patient>& patients, const std::vector<PatientId>& hits,
+                              const std::vector<PatientId>& misses) {
+    PhaseTimes times;
+    times.checksum = 0;
+    Map registry;
+    
+    size_t allocationsBefore = allocationCount;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Patient& patient : patients) {
+        registry.insert(std::make_pair(patient.getPatientID(), patient));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    times.insertNanos = nanosPerOp(start, end, patients.size());
+    times.allocationsPerInsert = static_cast<double>(allocationCount - allocationsBefore) / patients.size();
+    
+    // Checksums keep the lookups from being optimised out
+    start = std::chrono::high_resolution_clock::now();
+    for (const PatientId& id : hits) {
+        auto it = registry.find(id);
+        if (it != registry.end()) times.checksum += it->second.getSeverityScore();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    times.hitNanos = nanosPerOp(start, end, hits.size());
+    
+    start = std::chrono::high_resolution_clock::now();
+    for (const PatientId& id : misses) {
+        if (registry.find(id) != registry.end()) times.checksum++;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    times.missNanos = nanosPerOp(start, end, misses.size());
+    
+    start = std::chrono::high_resolution_clock::now();
+    for (const PatientId& id : hits) {
+        times.checksum += static_cast<long long>(registry.erase(id));
+    }
+    end = std::chrono::high_resolution_clock::now();
+    times.eraseNanos = nanosPerOp(start, end, hits.size());
+    return times;
+}
+
+static void printRow(const char* operation, double standard, double flat) {
+    std::cout << "║ " << std::left << std::setw(22) << operation << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << standard
+              << std::setw(14) << flat
+              << std::setw(13) << std::setprecision(2) << (flat > 0 ? standard / flat : 0.0) << "x"
+              << "   ║\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atoll(argv[1])) : 1000000;
+    
+    std::mt19937 rng(42);
+    std::vector<Patient> patients;
+    patients.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = 60 + static_cast<int>(rng() % 100);
+        vitals.oxygenLevel = 85 + static_cast<int>(rng() % 15);
+        patients.push_back(Patient("P" + std::to_string(i), vitals, "ER"));
+    }
+    
+    // Hits in random order, so neither table is walked in insertion order
+    std::vector<PatientId> hits;
+    hits.reserve(count);
+    for (const Patient& patient : patients) {
+        hits.push_back(patient.getPatientID());
+    }
+    std::shuffle(hits.begin(), hits.end(), rng);
+    std::vector<PatientId> misses;
+    misses.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        misses.push_back("Q" + std::to_string(i));
+    }
+    
+    PhaseTimes standard = runRegistry<std::unordered_map<PatientId, Patient> >(patients, hits, misses);
+    PhaseTimes flat = runRegistry<FlatHashMap<PatientId, Patient> >(patients, hits, misses);
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║            PATIENT REGISTRY BENCHMARK (" << std::setw(7) << count << " patients)           ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Operation (ns/op)      unordered_map   FlatHashMap   Speedup       ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    printRow("Insert", standard.insertNanos, flat.insertNanos);
+    printRow("Lookup (hit)", standard.hitNanos, flat.hitNanos);
+    printRow("Lookup (miss)", standard.missNanos, flat.missNanos);
+    printRow("Erase", standard.eraseNanos, flat.eraseNanos);
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Allocations per insert " << std::setw(13) << std::setprecision(2) << standard.allocationsPerInsert
+              << std::setw(14) << flat.allocationsPerInsert << "                 ║\n";
+    std::cout << "║ Checksums " << (standard.checksum == flat.checksum ? "match   " : "MISMATCH")
+              << "                                                 ║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "../include/algorithms/Graph.hpp"
+#include "../include/algorithms/DijkstraRouter.hpp"
+#include "../include/utils/Simulation.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+#include <string>
+
+// Point-to-point routing benchmark on generated campus grids.
+// Usage: bench_routing.exe [queries]
+
+struct ModeStats {
+    double totalMicros;
+    size_t totalSettled;
+    
+    ModeStats() : totalMicros(0.0), totalSettled(0) {}
+};
+
+static std::string gridNode(int r, int c) {
+    std::stringstream ss;
+    ss << "N_" << r << "_" << c;
+    return ss.str();
+}
+
+static ModeStats runQueries(DijkstraRouter& router, RoutingMode mode,
+                            const std::vector<std::pair<std::string, std::string>>& queries,
+                            double& checksum) {
+    ModeStats stats;
+    for (const auto& query : queries) {
+        auto start = std::chrono::high_resolution_clock::now();
+        RouteInfo route = router.findShortestPath(query.first, query.second, mode);
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        stats.totalMicros += std::chrono::duration<double, std::micro>(end - start).count();
+        stats.totalSettled += router.getLastSettledCount();
+        checksum += route.totalDistance;
+    }
+    return stats;
+}
+
+int main(int argc, char* argv[]) {
+    int queryCount = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const int sides[] = {50, 100, 200, 300};
+    std::stringstream hierarchyRows;
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              POINT-TO-POINT ROUTING BENCHMARK                      ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Grid      Nodes   Mode            Avg settled   Avg time (μs)      ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    for (int side : sides) {
+        Graph layout;
+        Simulation::generateCampusLayout(layout, side, side);
+        layout.getCompactView();    // build the CSR view outside the timed region
+        
+        std::srand(7);
+        std::vector<std::pair<std::string, std::string>> queries;
+        for (int i = 0; i < queryCount; i++) {
+            queries.push_back(std::make_pair(gridNode(std::rand() % side, std::rand() % side),
+                                             gridNode(std::rand() % side, std::rand() % side)));
+        }
+        
+        DijkstraRouter router(&layout);
+        const HierarchyStats& hierarchy = router.buildContractionHierarchy();
+        double hierarchyQueryMicros = 0.0;
+        
+        // Plain Dijkstra twice: binary heap, then Dial's buckets (grid weights are integers)
+        const RoutingMode modes[] = {RoutingMode::DIJKSTRA, RoutingMode::DIJKSTRA, 
+                                     RoutingMode::BIDIRECTIONAL, RoutingMode::A_STAR,
+                                     RoutingMode::CONTRACTION_HIERARCHY};
+        const char* names[] = {"Dijkstra heap", "Dijkstra Dial", "Bidirectional", "A*", 
+                               "Contraction H."};
+        
+        double baseline = 0.0;
+        for (int m = 0; m < 5; m++) {
+            double checksum = 0.0;
+            router.setBucketQueueEnabled(m != 0);
+            ModeStats stats = runQueries(router, modes[m], queries, checksum);
+            if (m == 0) baseline = checksum;
+            if (modes[m] == RoutingMode::CONTRACTION_HIERARCHY) {
+                hierarchyQueryMicros = stats.totalMicros / queries.size();
+            }
+            
+            std::cout << "║ " << std::setw(3) << side << "x" << std::setw(3) << std::left << side
+                      << std::right << std::setw(8) << side * side << "   "
+                      << std::setw(14) << std::left << names[m] << std::right
+                      << std::setw(12) << stats.totalSettled / queries.size()
+                      << std::setw(14) << std::fixed << std::setprecision(1)
+                      << stats.totalMicros / queries.size()
+                      << (checksum == baseline ? "         " : " MISMATCH") << "║\n";
+        }
+        
+        hierarchyRows << "║ " << std::setw(3) << side << "x" << std::setw(3) << std::left << side
+                      << std::right << std::setw(11) << hierarchy.shortcutCount
+                      << std::setw(10) << std::fixed << std::setprecision(2)
+                      << static_cast<double>(hierarchy.shortcutCount) / hierarchy.nodeCount
+                      << std::setw(12) << std::setprecision(1) << hierarchy.preprocessingMicros / 1000.0
+                      << std::setw(12) << hierarchy.memoryBytes / 1024.0
+                      << std::setw(12) << hierarchyQueryMicros << "   ║\n";
+    }
+    
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              CONTRACTION HIERARCHY PREPROCESSING                   ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Grid     Shortcuts  Per node   Time (ms) Memory (KB)  Query (μs)   ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << hierarchyRows.str();
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
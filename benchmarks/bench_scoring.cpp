@@ -0,0 +1,88 @@
+#include "../include/data_structures/PatientColumns.hpp"
+#include "../include/core/Patient.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+// Re-scoring a whole population: Patient::calculateSeverityAt over an array
+// of Patient objects against PatientColumns' batch scorer on each path.
+// Usage: bench_scoring.exe [patients]
+
+static const int ROUNDS = 5;
+
+template<typename Score>
+static double bestMillis(Score score) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        score();
+        auto end = std::chrono::high_resolution_clock::now();
+        double millis = std::chrono::duration<double, std::milli>(end - start).count();
+        if (round == 0 || millis < best) best = millis;
+    }
+    return best;
+}
+
+static void printRow(const char* method, double millis, size_t patients, bool matches) {
+    std::cout << "║ " << std::left << std::setw(26) << method << std::right
+              << std::setw(10) << std::fixed << std::setprecision(2) << millis
+              << std::setw(16) << std::setprecision(1) << patients / millis / 1000.0
+              << (matches ? "               " : "       MISMATCH") << "║\n";
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = (argc > 1) ? static_cast<size_t>(std::atoll(argv[1])) : 4000000;
+    const time_t now = 1700000000;
+    
+    // Vitals spread over every band, arrivals over the last day
+    std::mt19937 rng(42);
+    std::vector<Patient> patients;
+    patients.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = 40 + static_cast<int>(rng() % 100);
+        vitals.bloodPressure = 80 + static_cast<int>(rng() % 100);
+        vitals.oxygenLevel = 85 + static_cast<int>(rng() % 16);
+        vitals.temperature = 34.5 + (rng() % 60) / 10.0;
+        Patient patient("P" + std::to_string(i), vitals, "ER");
+        patient.setArrivalTime(now - static_cast<time_t>(rng() % 86400));
+        patients.push_back(patient);
+    }
+    PatientColumns columns;
+    columns.append(patients);
+    
+    std::vector<int32_t> expected(count);
+    double objectMillis = bestMillis([&]() {
+        for (size_t i = 0; i < count; i++) {
+            expected[i] = patients[i].calculateSeverityAt(now);
+        }
+    });
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║        SEVERITY RE-SCORING BENCHMARK (" << std::setw(7) << count << " patients)            ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Method                      Time (ms)   M patients/s               ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    printRow("Patient objects", objectMillis, count, true);
+    
+    const ScoringPath paths[] = {ScoringPath::SCALAR, ScoringPath::SSE2, ScoringPath::AVX2};
+    for (ScoringPath path : paths) {
+        if (!PatientColumns::isSupported(path)) continue;
+        std::vector<int32_t> scores(count);
+        double millis = bestMillis([&]() {
+            columns.scoreRange(0, count, now, scores.data(), path);
+        });
+        std::string label = std::string("Columns, ") + PatientColumns::pathName(path);
+        printRow(label.c_str(), millis, count, scores == expected);
+    }
+    
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Default path: " << std::left << std::setw(53)
+              << PatientColumns::pathName(PatientColumns::bestPath()) << std::right << "║\n";
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    return 0;
+}
@@ -0,0 +1,225 @@
+#include "../include/data_structures/MinHeap.hpp"
+#include "../include/data_structures/IndexedMinHeap.hpp"
+#include "../include/data_structures/PairingHeap.hpp"
+#include "../include/data_structures/TriageQueue.hpp"
+#include "../include/data_structures/SeverityBucketQueue.hpp"
+#include "../include/core/Patient.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Triage queue throughput during a surge: n arrivals, then n extractions.
+// Usage: bench_triage.exe [maxPatients]
+
+static std::vector<Patient> makeSurge(int count) {
+    std::srand(17);
+    std::vector<Patient> patients;
+    patients.reserve(count);
+    for (int i = 0; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = 40 + std::rand() % 100;
+        vitals.bloodPressure = 70 + std::rand() % 110;
+        vitals.oxygenLevel = 80 + std::rand() % 20;
+        vitals.temperature = 35.0 + (std::rand() % 60) / 10.0;
+        patients.push_back(Patient("P" + std::to_string(i), vitals, "ER"));
+    }
+    return patients;
+}
+
+static double elapsedMillis(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count();
+}
+
+static void runQueue(TriageBackend backend, const std::vector<Patient>& surge,
+                     double& addMillis, double& extractMillis) {
+    TriageQueue queue(backend);
+    queue.setVerbose(false);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Patient& patient : surge) {
+        queue.addPatient(patient);
+    }
+    addMillis = elapsedMillis(start);
+    start = std::chrono::high_resolution_clock::now();
+    while (!queue.isEmpty()) {
+        queue.getNextPatient();
+    }
+    extractMillis = elapsedMillis(start);
+}
+
+static void printMergeRow(const char* name, double millis, int departments) {
+    std::cout << "║ " << std::setw(36) << std::left << name << std::right << std::fixed 
+              << std::setprecision(1) << std::setw(12) << millis 
+              << std::setw(15) << millis * 1000.0 / departments << "    ║\n";
+}
+
+// Overflow consolidation: many department lists merged into one large queue
+static void runMergeBenchmark(int centralSize, int departments, int perDepartment) {
+    std::vector<Patient> central = makeSurge(centralSize);
+    std::vector<Patient> waiting = makeSurge(departments * perDepartment);
+    for (size_t i = 0; i < waiting.size(); i++) {
+        waiting[i] = Patient("D" + std::to_string(i), waiting[i].getVitalSigns(), "ER");
+    }
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              DEPARTMENT MERGE (MELD-HEAVY)                         ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Central queue " << std::setw(7) << centralSize << ", " << std::setw(4) << departments 
+              << " departments x " << std::setw(4) << perDepartment << " patients merged     ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Method                                 Total (ms)   Per merge (μs) ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    // Heap layer only: records, no Patients or ID index
+    {
+        MinHeap<TriageRecord, 4> main;
+        std::vector<MinHeap<TriageRecord, 4> > parts(departments);
+        for (int i = 0; i < centralSize; i++) main.insert(TriageRecord(central[i].getSeverityScore(), i, i));
+        for (size_t i = 0; i < waiting.size(); i++) {
+            parts[i / perDepartment].insert(TriageRecord(waiting[i].getSeverityScore(), i, i));
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        for (MinHeap<TriageRecord, 4>& part : parts) {
+            while (!part.isEmpty()) main.insert(part.extractMin());
+        }
+        printMergeRow("MinHeap: drain + reinsert", elapsedMillis(start), departments);
+    }
+    {
+        IndexedMinHeap<TriageRecord> main;
+        std::vector<std::vector<TriageRecord> > parts(departments);
+        for (int i = 0; i < centralSize; i++) main.insert(TriageRecord(central[i].getSeverityScore(), i, i));
+        for (size_t i = 0; i < waiting.size(); i++) {
+            parts[i / perDepartment].push_back(TriageRecord(waiting[i].getSeverityScore(), i, i));
+        }
+        std::vector<IndexedMinHeap<TriageRecord>::Handle> handles;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const std::vector<TriageRecord>& part : parts) {
+            main.insertBatch(part, handles);
+        }
+        printMergeRow("IndexedMinHeap: insertBatch", elapsedMillis(start), departments);
+    }
+    {
+        PairingHeap<TriageRecord> main;
+        std::vector<PairingHeap<TriageRecord> > parts(departments);
+        for (int i = 0; i < centralSize; i++) main.insert(TriageRecord(central[i].getSeverityScore(), i, i));
+        for (size_t i = 0; i < waiting.size(); i++) {
+            parts[i / perDepartment].insert(TriageRecord(waiting[i].getSeverityScore(), i, i));
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        for (PairingHeap<TriageRecord>& part : parts) {
+            main.meld(std::move(part));
+        }
+        printMergeRow("PairingHeap: meld", elapsedMillis(start), departments);
+    }
+    
+    // Whole queues: Patients move stores and join the ID index as well
+    const TriageBackend backends[] = {TriageBackend::INDEXED_HEAP, TriageBackend::PAIRING_HEAP};
+    const char* names[] = {"TriageQueue::mergeFrom (indexed)", "TriageQueue::mergeFrom (pairing)"};
+    for (int b = 0; b < 2; b++) {
+        TriageQueue main(backends[b]);
+        main.setVerbose(false);
+        main.addPatientsBatch(central);
+        std::vector<TriageQueue> parts(departments, TriageQueue(backends[b]));
+        for (size_t i = 0; i < waiting.size(); i++) {
+            parts[i / perDepartment].setVerbose(false);
+            parts[i / perDepartment].addPatient(waiting[i]);
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        for (TriageQueue& part : parts) {
+            main.mergeFrom(std::move(part));
+        }
+        printMergeRow(names[b], elapsedMillis(start), departments);
+    }
+    
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+}
+
+int main(int argc, char* argv[]) {
+    int maxPatients = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    
+    std::cout << "\n╔════════════════════════════════════════════════════════════════════╗\n";
+    std::cout << "║              TRIAGE QUEUE SURGE BENCHMARK                          ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Heap element: Patient " << std::setw(4) << sizeof(Patient) 
+              << " bytes, TriageRecord " << std::setw(3) << sizeof(TriageRecord) 
+              << " bytes           ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    std::cout << "║ Patients   Queue                      Add (ms)     Extract (ms)    ║\n";
+    std::cout << "╠════════════════════════════════════════════════════════════════════╣\n";
+    
+    for (int n = 10000; n <= maxPatients; n *= 10) {
+        std::vector<Patient> surge = makeSurge(n);
+        
+        // Baseline: binary heap of full Patient copies
+        MinHeap<Patient> patientHeap;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const Patient& patient : surge) {
+            patientHeap.insert(patient);
+        }
+        double heapAdd = elapsedMillis(start);
+        start = std::chrono::high_resolution_clock::now();
+        while (!patientHeap.isEmpty()) {
+            patientHeap.extractMin();
+        }
+        double heapExtract = elapsedMillis(start);
+        
+        // The same ordering work on 12-byte records alone, without the ID index
+        IndexedMinHeap<TriageRecord> recordHeap;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < n; i++) {
+            recordHeap.insert(TriageRecord(surge[i].getSeverityScore(), i, i));
+        }
+        double recordAdd = elapsedMillis(start);
+        start = std::chrono::high_resolution_clock::now();
+        while (!recordHeap.isEmpty()) {
+            recordHeap.extractMin();
+        }
+        double recordExtract = elapsedMillis(start);
+        
+        // Bare bucket queue over the same slots
+        SeverityBucketQueue buckets;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < n; i++) {
+            buckets.insert(i, surge[i].getSeverityScore());
+        }
+        double bucketAdd = elapsedMillis(start);
+        start = std::chrono::high_resolution_clock::now();
+        while (!buckets.isEmpty()) {
+            buckets.extractMin();
+        }
+        double bucketExtract = elapsedMillis(start);
+        
+        double queueAdd, queueExtract, bucketQueueAdd, bucketQueueExtract;
+        double pairingQueueAdd, pairingQueueExtract;
+        runQueue(TriageBackend::INDEXED_HEAP, surge, queueAdd, queueExtract);
+        runQueue(TriageBackend::SEVERITY_BUCKETS, surge, bucketQueueAdd, bucketQueueExtract);
+        runQueue(TriageBackend::PAIRING_HEAP, surge, pairingQueueAdd, pairingQueueExtract);
+        
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "MinHeap<Patient>" << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(11) << heapAdd << std::setw(17) << heapExtract << "    ║\n";
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "IndexedMinHeap<Record>" << std::right 
+                  << std::setw(11) << recordAdd << std::setw(17) << recordExtract << "    ║\n";
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "TriageQueue (records)" << std::right 
+                  << std::setw(11) << queueAdd << std::setw(17) << queueExtract << "    ║\n";
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "SeverityBucketQueue" << std::right 
+                  << std::setw(11) << bucketAdd << std::setw(17) << bucketExtract << "    ║\n";
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "TriageQueue (buckets)" << std::right 
+                  << std::setw(11) << bucketQueueAdd << std::setw(17) << bucketQueueExtract << "    ║\n";
+        std::cout << "║ " << std::setw(8) << n << "   " << std::setw(24) << std::left 
+                  << "TriageQueue (pairing)" << std::right 
+                  << std::setw(11) << pairingQueueAdd << std::setw(17) << pairingQueueExtract << "    ║\n";
+    }
+    
+    std::cout << "╚════════════════════════════════════════════════════════════════════╝\n";
+    
+    runMergeBenchmark(maxPatients / 5, 200, 500);
+    return 0;
+}
@@ -20,23 +20,41 @@ if errorlevel 1 goto :error
 g++ -std=c++11 -Iinclude -c src/core/MedicalStaff.cpp -o build/MedicalStaff.o 2>>build/error.log
 if errorlevel 1 goto :error
 
-g++ -std=c++11 -Iinclude -c src/core/EmergencyResponseSystem.cpp -o build/EmergencyResponseSystem.o 2>>build/error.log
+g++ -std=c++11 -pthread -Iinclude -c src/core/EmergencyResponseSystem.cpp -o build/EmergencyResponseSystem.o 2>>build/error.log
 if errorlevel 1 goto :error
 
 echo Compiling Data Structures...
 g++ -std=c++11 -Iinclude -c src/data_structures/TriageQueue.cpp -o build/TriageQueue.o 2>>build/error.log
 if errorlevel 1 goto :error
 
-g++ -std=c++11 -Iinclude -c src/data_structures/PatientState.cpp -o build/PatientState.o 2>>build/error.log
+g++ -std=c++11 -Iinclude -c src/data_structures/UndoJournal.cpp -o build/UndoJournal.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -Iinclude -c src/data_structures/SeverityBucketQueue.cpp -o build/SeverityBucketQueue.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -pthread -Iinclude -c src/data_structures/ConcurrentTriageQueue.cpp -o build/ConcurrentTriageQueue.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -Iinclude -c src/data_structures/PatientColumns.cpp -o build/PatientColumns.o 2>>build/error.log
 if errorlevel 1 goto :error
 
 echo Compiling Algorithms...
 g++ -std=c++11 -Iinclude -c src/algorithms/Graph.cpp -o build/Graph.o 2>>build/error.log
 if errorlevel 1 goto :error
 
+g++ -std=c++11 -Iinclude -c src/algorithms/CompactGraph.cpp -o build/CompactGraph.o 2>>build/error.log
+if errorlevel 1 goto :error
+
 g++ -std=c++11 -Iinclude -c src/algorithms/DijkstraRouter.cpp -o build/DijkstraRouter.o 2>>build/error.log
 if errorlevel 1 goto :error
 
+g++ -std=c++11 -Iinclude -c src/algorithms/ContractionHierarchy.cpp -o build/ContractionHierarchy.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -Iinclude -c src/algorithms/ShortestPathTree.cpp -o build/ShortestPathTree.o 2>>build/error.log
+if errorlevel 1 goto :error
+
 g++ -std=c++11 -Iinclude -c src/algorithms/MSTGenerator.cpp -o build/MSTGenerator.o 2>>build/error.log
 if errorlevel 1 goto :error
 
@@ -56,8 +74,17 @@ if errorlevel 1 goto :error
 g++ -std=c++11 -Iinclude -c src/utils/Simulation.cpp -o build/Simulation.o 2>>build/error.log
 if errorlevel 1 goto :error
 
+g++ -std=c++11 -pthread -Iinclude -c src/utils/WriteAheadLog.cpp -o build/WriteAheadLog.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -pthread -Iinclude -c src/utils/WorkerPool.cpp -o build/WorkerPool.o 2>>build/error.log
+if errorlevel 1 goto :error
+
+g++ -std=c++11 -Iinclude -c src/utils/FileIO.cpp -o build/FileIO.o 2>>build/error.log
+if errorlevel 1 goto :error
+
 echo Linking...
-g++ -std=c++11 -Iinclude main.cpp build/*.o -o hospital.exe 2>>build/error.log
+g++ -std=c++11 -pthread -Iinclude main.cpp build/*.o -o hospital.exe 2>>build/error.log
 if errorlevel 1 goto :error
 
 echo.
@@ -0,0 +1,92 @@
+#ifndef COMPACT_GRAPH_HPP
+#define COMPACT_GRAPH_HPP
+
+#include "../core/HospitalRoom.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+class Graph;
+
+// Frozen compressed-sparse-row (CSR) view of a Graph.
+// Room names are interned to dense uint32_t indices once, and the outgoing
+// corridors of node u live in targets/weights[offsets[u] .. offsets[u+1]).
+class CompactGraph {
+public:
+    static const uint32_t INVALID_NODE = 0xFFFFFFFFu;
+
+    // Largest corridor weight a bucket queue will take; one bucket per metre
+    static const uint32_t MAX_BUCKET_WEIGHT = 4096;
+    
+private:
+    std::vector<uint32_t> offsets;      // size nodeCount + 1
+    std::vector<uint32_t> targets;      // size edgeCount
+    std::vector<double> weights;        // size edgeCount
+    
+    // Reverse (incoming) adjacency; entries point back at forward edge slots
+    // so a weight lives in exactly one place
+    std::vector<uint32_t> reverseOffsets;   // size nodeCount + 1
+    std::vector<uint32_t> reverseSources;   // size edgeCount
+    std::vector<uint32_t> reverseEdges;     // size edgeCount
+
+    std::vector<LocationId> nodeNames;                 // index -> name
+    std::unordered_map<LocationId, uint32_t> nodeIndex;  // name -> index
+    std::vector<Coordinates> positions;
+
+    // Corridors shorter than the straight line between their rooms; any such
+    // edge makes the Euclidean A* heuristic inadmissible
+    uint32_t subEuclideanEdges;
+    
+    // Corridors whose weight is not a whole number in [0, MAX_BUCKET_WEIGHT];
+    // any such edge rules out the bucket queue. Closed (infinite) corridors
+    // are never relaxed, so they don't count.
+    uint32_t irregularEdges;
+    uint32_t maxIntegerWeight;      // upper bound; not lowered when weights drop
+    
+    uint32_t intern(const LocationId& name);
+    
+    // Adds (count = 1) or removes (count = -1) an edge from the weight tallies
+    void classifyEdge(uint32_t from, uint32_t to, double weight, int count);
+    
+    // Only Graph may change a weight, and only through its change log
+    friend class Graph;
+    void patchEdgeWeight(uint32_t from, uint32_t edge, double weight);
+
+public:
+    CompactGraph();
+    explicit CompactGraph(const Graph& graph);
+
+    // Interning table
+    uint32_t indexOf(const LocationId& name) const;    // INVALID_NODE if unknown
+    const LocationId& nameOf(uint32_t node) const { return nodeNames[node]; }
+    const Coordinates& positionOf(uint32_t node) const { return positions[node]; }
+
+    // Adjacency - O(1)
+    uint32_t edgesBegin(uint32_t node) const { return offsets[node]; }
+    uint32_t edgesEnd(uint32_t node) const { return offsets[node + 1]; }
+    uint32_t edgeTarget(uint32_t edge) const { return targets[edge]; }
+    double edgeWeight(uint32_t edge) const { return weights[edge]; }
+
+    // Reverse adjacency - incoming corridors of a node, O(1)
+    uint32_t reverseBegin(uint32_t node) const { return reverseOffsets[node]; }
+    uint32_t reverseEnd(uint32_t node) const { return reverseOffsets[node + 1]; }
+    uint32_t reverseSource(uint32_t slot) const { return reverseSources[slot]; }
+    double reverseWeight(uint32_t slot) const { return weights[reverseEdges[slot]]; }
+    uint32_t reverseEdge(uint32_t slot) const { return reverseEdges[slot]; }
+    
+    // Heuristic support
+    double straightLineDistance(uint32_t from, uint32_t to) const;
+    bool isEuclideanAdmissible() const { return subEuclideanEdges == 0; }
+    
+    // Bucket queue support
+    bool hasSmallIntegerWeights() const { return irregularEdges == 0; }
+    uint32_t getMaxIntegerWeight() const { return maxIntegerWeight; }
+    
+    uint32_t getNodeCount() const { return static_cast<uint32_t>(nodeNames.size()); }
+    uint32_t getEdgeCount() const { return static_cast<uint32_t>(targets.size()); }
+    size_t getMemoryUsage() const;
+};
+
+#endif // COMPACT_GRAPH_HPP
@@ -0,0 +1,87 @@
+#ifndef CONTRACTION_HIERARCHY_HPP
+#define CONTRACTION_HIERARCHY_HPP
+
+#include "CompactGraph.hpp"
+#include "SearchSpace.hpp"
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+struct HierarchyStats {
+    long long preprocessingMicros;
+    uint32_t nodeCount;
+    uint32_t originalEdges;
+    uint32_t shortcutCount;
+    size_t memoryBytes;
+    
+    HierarchyStats() : preprocessingMicros(0), nodeCount(0), originalEdges(0),
+                       shortcutCount(0), memoryBytes(0) {}
+};
+
+// Contraction hierarchy over a frozen CompactGraph.
+// Nodes are contracted one by one (least important first, by edge difference),
+// adding a shortcut u->x whenever u->v->x is the only shortest u-x path.
+// Queries then only ever climb to higher-ranked nodes from both ends.
+class ContractionHierarchy {
+private:
+    struct Arc {
+        uint32_t node;        // Other endpoint
+        double weight;
+        uint32_t middle;      // Contracted node this shortcut bypasses, or INVALID_NODE
+        
+        Arc(uint32_t n, double w, uint32_t m) : node(n), weight(w), middle(m) {}
+    };
+    
+    std::vector<uint32_t> rank;                 // Contraction order of every node
+    
+    // Upward search graph. For node u, forward arcs u->x with rank[x] > rank[u],
+    // backward arcs x->u (stored at u) with rank[x] > rank[u].
+    std::vector<uint32_t> upOffsets;
+    std::vector<Arc> upArcs;
+    std::vector<uint32_t> downOffsets;
+    std::vector<Arc> downArcs;
+    
+    HierarchyStats stats;
+    
+    // Witness search working memory, only used during preprocessing
+    std::vector<double> witnessDistance;
+    std::vector<uint32_t> witnessTouched;
+    std::vector<uint32_t> witnessHops;         // Arcs from the search source
+    std::vector<uint8_t> witnessTarget;
+    std::vector<std::pair<double, uint32_t> > witnessHeap;
+    
+    uint32_t processNode(std::vector<std::vector<Arc> >& out,
+                         std::vector<std::vector<Arc> >& in,
+                         const std::vector<uint8_t>& contracted,
+                         uint32_t node, bool simulate);
+    void witnessSearch(const std::vector<std::vector<Arc> >& out,
+                       const std::vector<uint8_t>& contracted,
+                       uint32_t source, uint32_t skipped, double limit,
+                       size_t targetCount, size_t settleLimit, uint32_t hopLimit);
+    static void addOrImproveArc(std::vector<Arc>& arcs, uint32_t node, double weight, uint32_t middle);
+    static void removeArc(std::vector<Arc>& arcs, uint32_t node);
+    
+    const Arc* findArc(uint32_t from, uint32_t to) const;
+    void unpackArc(uint32_t from, uint32_t to, std::vector<uint32_t>& path) const;
+    
+public:
+    ContractionHierarchy();
+    
+    // Preprocessing - O(V * witness search) in practice
+    void build(const CompactGraph& graph);
+    bool isBuilt() const { return !rank.empty(); }
+    
+    // Bidirectional upward search with stall-on-demand; returns the meeting
+    // node or INVALID_NODE
+    uint32_t query(uint32_t source, uint32_t target, SearchSpace& forward, SearchSpace& backward) const;
+    
+    // Expands the upward path through the meeting node into original nodes
+    std::vector<uint32_t> unpackPath(uint32_t source, uint32_t target, uint32_t meeting,
+                                     const SearchSpace& forward, const SearchSpace& backward) const;
+    
+    const HierarchyStats& getStats() const { return stats; }
+    void displayStats() const;
+};
+
+#endif // CONTRACTION_HIERARCHY_HPP
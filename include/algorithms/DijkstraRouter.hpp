@@ -2,46 +2,194 @@
 #define DIJKSTRA_ROUTER_HPP
 
 #include "Graph.hpp"
+#include "SearchSpace.hpp"
+#include "ContractionHierarchy.hpp"
+#include "ShortestPathTree.hpp"
+#include "../utils/WorkerPool.hpp"
 #include <vector>
-#include <string>
+#include <list>
+#include <utility>
+#include <unordered_map>
 #include <limits>
+#include <cstdint>
 
 struct RouteInfo {
-    std::vector<std::string> path;
+    std::vector<LocationId> path;
     double totalDistance;
     int nodeCount;
     
     RouteInfo() : totalDistance(0.0), nodeCount(0) {}
 };
 
+enum class RoutingMode {
+    DIJKSTRA,       // Uniform search ball around the start node
+    A_STAR,         // Goal-directed, straight-line distance as heuristic
+    BIDIRECTIONAL,  // Forward from start and backward from end, meet in the middle
+    CONTRACTION_HIERARCHY   // Upward search over a preprocessed hierarchy
+};
+
 class DijkstraRouter {
 private:
     Graph* hospitalMap;
+    SearchSpace searchSpace;
+    SearchSpace backwardSpace;      // Bidirectional mode: search over reverse edges
+    RoutingMode routingMode;
+    bool bucketQueueEnabled;
+    unsigned batchThreadCount;      // 0 = one per hardware thread
+    
+    // Batch workers and their search spaces (slot 0 is the calling thread's).
+    // Both outlive a batch; prepare() only regrows a space when the CSR
+    // view's node count changes.
+    WorkerPool batchPool;
+    std::vector<SearchSpace> batchForward;
+    std::vector<SearchSpace> batchBackward;
+    bool heuristicWarningShown;
+    bool hierarchyWarningShown;
+    size_t lastSettledCount;
+    
+    // Optional preprocessing; only valid for the graph version it was built on
+    ContractionHierarchy hierarchy;
+    uint64_t hierarchyVersion;
+    
+    // Incrementally maintained trees for busy sources (ENTRANCE, ER, ...)
+    std::unordered_map<LocationId, ShortestPathTree> maintainedTrees;
+    size_t lastRepairCount;
+    
+    // Bounded LRU cache of routes keyed by (from, to), most recent at the front.
+    // Entries are only valid for cacheVersion of the graph. Both endpoints
+    // are stored inline, so looking a route up never allocates.
+    struct RouteKey {
+        LocationId start;
+        LocationId end;
+        
+        RouteKey() {}
+        RouteKey(const LocationId& s, const LocationId& e) : start(s), end(e) {}
+        bool operator==(const RouteKey& other) const {
+            return start == other.start && end == other.end;
+        }
+    };
+    struct RouteKeyHash {
+        size_t operator()(const RouteKey& key) const { return key.start.hash() * 31 + key.end.hash(); }
+    };
+    struct CachedRoute {
+        RouteKey key;
+        RouteInfo route;
+    };
+    std::list<CachedRoute> routeCache;
+    std::unordered_map<RouteKey, std::list<CachedRoute>::iterator, RouteKeyHash> routeCacheIndex;
+    size_t routeCacheCapacity;
+    uint64_t cacheVersion;
+    size_t cacheHits;
+    size_t cacheMisses;
     
     struct DijkstraNode {
-        std::string id;
+        uint32_t id;          // dense index into the CompactGraph view
         double distance;
         
-        DijkstraNode(const std::string& nodeId, double dist) 
+        DijkstraNode(uint32_t nodeId, double dist) 
             : id(nodeId), distance(dist) {}
         
         bool operator>(const DijkstraNode& other) const {
             return distance > other.distance;
         }
     };
-
+    
+    // Single-source Dijkstra that stops once every target is settled.
+    // Picks the bucket queue when every corridor weight is a small integer.
+    void runDijkstra(const CompactGraph& view, uint32_t source,
+                     const std::vector<uint32_t>& targets, SearchSpace& space) const;
+    void runHeapSearch(const CompactGraph& view, uint32_t source,
+                       size_t remaining, SearchSpace& space) const;
+    void runBucketSearch(const CompactGraph& view, uint32_t source,
+                         size_t remaining, SearchSpace& space) const;
+    void runAStar(const CompactGraph& view, uint32_t source, uint32_t target,
+                  SearchSpace& space) const;
+    uint32_t runBidirectional(const CompactGraph& view, uint32_t source, uint32_t target,
+                              SearchSpace& forward, SearchSpace& backward) const;
+    RouteInfo buildBidirectionalRoute(const CompactGraph& view, const SearchSpace& forward,
+                                      const SearchSpace& backward, uint32_t source,
+                                      uint32_t target, uint32_t meeting) const;
+    RouteInfo buildRoute(const CompactGraph& view, const SearchSpace& space,
+                         uint32_t source, uint32_t target) const;
+    
+    // Applies the A*/hierarchy fallbacks (with their one-time warnings)
+    RoutingMode resolveMode(const CompactGraph& view, RoutingMode mode);
+    // One point-to-point query in the given scratch space; touches no router state
+    RouteInfo computeRoute(const CompactGraph& view, uint32_t source, uint32_t target,
+                           RoutingMode mode, SearchSpace& forward, SearchSpace& backward,
+                           size_t& settled) const;
+    RouteInfo buildTreeRoute(const CompactGraph& view, const ShortestPathTree& tree,
+                             uint32_t target) const;
+    ShortestPathTree* findMaintainedTree(const LocationId& start);
+    void trimWeightLog();
+    
+    void validateRouteCache();
+    const RouteInfo* findCachedRoute(const RouteKey& key);
+    void storeCachedRoute(const RouteKey& key, const RouteInfo& route);
+    
 public:
     DijkstraRouter(Graph* graph);
     
-    // Main algorithm - O((V+E) log V) complexity
-    RouteInfo findShortestPath(const std::string& start, const std::string& end);
+    // Main algorithm - O((V+E) log V) complexity, using the router's mode.
+    // Served from the route cache when the graph has not changed since.
+    RouteInfo findShortestPath(const LocationId& start, const LocationId& end);
+    // Same, written into route: a cached route reuses route's path storage,
+    // so a caller that keeps one RouteInfo around routes without allocating
+    void findShortestPath(const LocationId& start, const LocationId& end, RouteInfo& route);
+    
+    // Explicit mode, always searched (bypasses the route cache)
+    RouteInfo findShortestPath(const LocationId& start, const LocationId& end,
+                               RoutingMode mode);
     
-    // Multiple destinations
+    // Many independent pairs, fanned out over the router's persistent worker
+    // threads. Results are in query order; cache and maintained trees are honoured.
+    std::vector<RouteInfo> findShortestPathsBatch(
+        const std::vector<std::pair<LocationId, LocationId>>& queries);
+    
+    // Multiple destinations - one shortest-path-tree search from start
     std::vector<RouteInfo> findPathsToMultipleDestinations(
-        const std::string& start, 
-        const std::vector<std::string>& destinations
+        const LocationId& start, 
+        const std::vector<LocationId>& destinations
     );
     
+    // Configuration
+    void setRoutingMode(RoutingMode mode);
+    RoutingMode getRoutingMode() const { return routingMode; }
+    
+    // Worker threads for batch routing - 0 uses every hardware thread
+    void setBatchThreadCount(unsigned threads) { batchThreadCount = threads; }
+    unsigned getBatchThreadCount() const { return batchThreadCount; }
+    unsigned getStartedWorkerCount() const { return batchPool.getThreadCount(); }
+    
+    // Dial's bucket queue for integer weights - on by default, off forces the heap
+    void setBucketQueueEnabled(bool enabled) { bucketQueueEnabled = enabled; }
+    bool usesBucketQueue() const;
+    
+    // Route cache - capacity 0 disables it
+    void setRouteCacheCapacity(size_t capacity);
+    size_t getRouteCacheCapacity() const { return routeCacheCapacity; }
+    size_t getRouteCacheSize() const { return routeCache.size(); }
+    void clearRouteCache();
+    
+    // Keep a shortest-path tree from source up to date across corridor weight
+    // changes; routes from it are then read off the tree. O((V+E) log V) once.
+    void maintainShortestPathTree(const LocationId& source);
+    void releaseShortestPathTree(const LocationId& source);
+    bool isTreeMaintained(const LocationId& source) const;
+    
+    // Contraction hierarchy preprocessing - rerun after changing the graph
+    const HierarchyStats& buildContractionHierarchy();
+    bool hasContractionHierarchy() const;
+    
+    // A* is only exact if no corridor is shorter than the straight line
+    bool validateHeuristic() const;
+    
+    // Statistics
+    size_t getLastSettledCount() const { return lastSettledCount; }
+    size_t getLastRepairCount() const { return lastRepairCount; }      // nodes re-labelled
+    size_t getCacheHits() const { return cacheHits; }
+    size_t getCacheMisses() const { return cacheMisses; }
+    
     // Utility
     void displayRoute(const RouteInfo& route) const;
 };
@@ -1,52 +1,108 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
-#include <string>
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <limits>
 #include "../core/HospitalRoom.hpp"
+#include "CompactGraph.hpp"
 
 struct Edge {
-    std::string from;
-    std::string to;
+    LocationId from;
+    LocationId to;
     double weight;
+    bool open;          // closed corridors keep their weight but cannot be walked
     
-    Edge() : weight(0.0) {}
-    Edge(const std::string& f, const std::string& t, double w) 
-        : from(f), to(t), weight(w) {}
+    Edge() : weight(0.0), open(true) {}
+    Edge(const LocationId& f, const LocationId& t, double w) 
+        : from(f), to(t), weight(w), open(true) {}
+    
+    // Weight as routing sees it: infinite while the corridor is closed
+    double effectiveWeight() const {
+        return open ? weight : std::numeric_limits<double>::infinity();
+    }
     
     bool operator<(const Edge& other) const {
         return weight < other.weight;
     }
 };
 
+// One effective-weight change of a CSR edge slot, for incremental consumers
+struct WeightChange {
+    uint32_t from;          // CompactGraph index of the corridor's start
+    uint32_t edge;          // CompactGraph edge slot
+    double oldWeight;
+    double newWeight;
+    
+    WeightChange(uint32_t f, uint32_t e, double oldW, double newW) 
+        : from(f), edge(e), oldWeight(oldW), newWeight(newW) {}
+};
+
 class Graph {
 private:
-    std::unordered_map<std::string, std::vector<Edge>> adjacencyList;
-    std::unordered_map<std::string, Coordinates> nodePositions;
+    std::unordered_map<LocationId, std::vector<Edge>> adjacencyList;
+    std::unordered_map<LocationId, Coordinates> nodePositions;
+    std::vector<LocationId> nodeOrder;     // insertion order, used for interning
     int vertexCount;
     int edgeCount;
-
+    uint64_t version;       // bumped on every mutation; caches compare against it
+    uint64_t topologyVersion;   // bumped only when rooms or corridors are added
+    
+    // Weight changes since the last topology change. Slots index the current
+    // CSR view, which weight changes patch in place instead of rebuilding.
+    // Positions are absolute: weightLog[0] is change number weightLogStart.
+    std::vector<WeightChange> weightLog;
+    uint64_t weightLogStart;
+    
+    // Applies fn to every from->to edge; returns how many there were
+    template <typename Fn>
+    int forEachEdge(const LocationId& from, const LocationId& to, Fn fn);
+    void patchEdgeWeight(const LocationId& from, size_t position, double oldWeight, double newWeight);
+    
+    // Lazily built CSR view, dropped whenever a room or corridor is added
+    mutable std::unique_ptr<CompactGraph> compactView;
+    
+    friend class CompactGraph;
+    
 public:
     Graph();
     
-    // Graph construction
-    void addNode(const std::string& nodeId, const Coordinates& position);
-    void addEdge(const std::string& from, const std::string& to, double weight);
-    void addBidirectionalEdge(const std::string& node1, const std::string& node2, double weight);
+    // Graph construction; negative or NaN weights throw std::invalid_argument
+    void addNode(const LocationId& nodeId, const Coordinates& position);
+    void addEdge(const LocationId& from, const LocationId& to, double weight);
+    void addBidirectionalEdge(const LocationId& node1, const LocationId& node2, double weight);
+    
+    // Dynamic corridors - apply to every from->to edge, false if there is none.
+    // O(out-degree of from); the CSR view is patched, not rebuilt. Negative
+    // or NaN weights throw std::invalid_argument.
+    bool updateEdgeWeight(const LocationId& from, const LocationId& to, double weight);
+    bool disableEdge(const LocationId& from, const LocationId& to);
+    bool enableEdge(const LocationId& from, const LocationId& to);
     
     // Getters
-    std::vector<Edge> getEdges(const std::string& node) const;
-    std::vector<std::string> getAllNodes() const;
+    const std::vector<Edge>& getEdges(const LocationId& node) const;
+    const std::vector<LocationId>& getAllNodes() const;        // insertion order
     std::vector<Edge> getAllEdges() const;
-    Coordinates getNodePosition(const std::string& node) const;
+    Coordinates getNodePosition(const LocationId& node) const;
     int getVertexCount() const { return vertexCount; }
     int getEdgeCount() const { return edgeCount; }
-    bool hasNode(const std::string& node) const;
+    uint64_t getVersion() const { return version; }
+    uint64_t getTopologyVersion() const { return topologyVersion; }
+    const std::vector<WeightChange>& getWeightLog() const { return weightLog; }
+    uint64_t getWeightLogStart() const { return weightLogStart; }
+    uint64_t getWeightLogEnd() const { return weightLogStart + weightLog.size(); }
+    // Drops changes before absolute position; readers behind it must rebuild
+    void trimWeightLog(uint64_t position);
+    bool hasNode(const LocationId& node) const;
+    
+    // Frozen CSR view for the routing/MST hot paths - built once, O(V + E)
+    const CompactGraph& getCompactView() const;
     
     // Utility
     void display() const;
-    double calculateEuclideanDistance(const std::string& node1, const std::string& node2) const;
+    double calculateEuclideanDistance(const LocationId& node1, const LocationId& node2) const;
 };
 
 #endif // GRAPH_HPP
\ No newline at end of file
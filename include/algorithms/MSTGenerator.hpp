@@ -4,6 +4,7 @@
 #include "Graph.hpp"
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 
 struct MSTResult {
     std::vector<Edge> edges;
@@ -16,19 +17,31 @@ struct MSTResult {
 // Union-Find data structure for Kruskal's algorithm
 class UnionFind {
 private:
-    std::unordered_map<std::string, std::string> parent;
-    std::unordered_map<std::string, int> rank;
+    std::unordered_map<LocationId, LocationId> parent;
+    std::unordered_map<LocationId, int> rank;
+    
+public:
+    void makeSet(const LocationId& node);
+    LocationId find(const LocationId& node);             // With path compression
+    bool unionSets(const LocationId& node1, const LocationId& node2);  // With union by rank
+};
 
+// Dense Union-Find over CompactGraph node indices (no string hashing)
+class IndexedUnionFind {
+private:
+    std::vector<uint32_t> parent;
+    std::vector<uint8_t> rank;
+    
 public:
-    void makeSet(const std::string& node);
-    std::string find(const std::string& node);           // With path compression
-    bool unionSets(const std::string& node1, const std::string& node2);  // With union by rank
+    explicit IndexedUnionFind(uint32_t nodeCount);
+    uint32_t find(uint32_t node);                        // With path halving
+    bool unionSets(uint32_t node1, uint32_t node2);      // With union by rank
 };
 
 class MSTGenerator {
 private:
     Graph* equipmentGraph;
-
+    
 public:
     MSTGenerator(Graph* graph);
     
@@ -0,0 +1,58 @@
+#ifndef SEARCH_SPACE_HPP
+#define SEARCH_SPACE_HPP
+
+#include "CompactGraph.hpp"
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+// Working memory for one search over a CompactGraph. Kept between queries so
+// only the entries a search actually touched are reset, not all V of them.
+struct SearchSpace {
+    std::vector<double> distance;
+    std::vector<uint32_t> previous;
+    std::vector<uint8_t> settled;
+    std::vector<uint8_t> isTarget;
+    std::vector<uint32_t> touched;
+    size_t settledCount;
+    
+    // Binary-heap frontier (distance, node); reused like the buckets below
+    std::vector<std::pair<double, uint32_t> > heap;
+    
+    // Dial's circular bucket array (bucket d % size holds tentative distance d);
+    // empty between searches, kept only so the buckets' storage is reused
+    std::vector<std::vector<uint32_t> > buckets;
+    
+    SearchSpace() : settledCount(0) {}
+    
+    void prepare(uint32_t nodeCount) {
+        if (distance.size() != nodeCount) {
+            distance.assign(nodeCount, std::numeric_limits<double>::infinity());
+            previous.assign(nodeCount, CompactGraph::INVALID_NODE);
+            settled.assign(nodeCount, 0);
+            isTarget.assign(nodeCount, 0);
+            touched.clear();
+            settledCount = 0;
+            return;
+        }
+        
+        for (uint32_t node : touched) {
+            distance[node] = std::numeric_limits<double>::infinity();
+            previous[node] = CompactGraph::INVALID_NODE;
+            settled[node] = 0;
+        }
+        touched.clear();
+        settledCount = 0;
+    }
+    
+    // Call before the first write to distance[node] in a search
+    void touch(uint32_t node) {
+        if (distance[node] == std::numeric_limits<double>::infinity()) {
+            touched.push_back(node);
+        }
+    }
+};
+
+#endif // SEARCH_SPACE_HPP
@@ -0,0 +1,58 @@
+#ifndef SHORTEST_PATH_TREE_HPP
+#define SHORTEST_PATH_TREE_HPP
+
+#include "Graph.hpp"
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+// Shortest-path tree from one fixed source, kept exact as corridor weights
+// change. Weight changes are read from the Graph's change log and repaired
+// locally: only the subtree hanging off a lengthened/closed tree edge, and
+// whatever a shortened/reopened edge improves, is re-labelled.
+class ShortestPathTree {
+private:
+    uint32_t source;
+    std::vector<double> distance;
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> parentEdge;       // CSR slot of the tree edge into each node
+    
+    // What the tree is exact for: a topology, plus a prefix of its weight log
+    // (an absolute log position, so trimming the log does not shift it)
+    uint64_t topologyVersion;
+    uint64_t logPosition;
+    size_t lastRelabelled;
+    
+    // Repair working memory
+    std::vector<uint8_t> affected;
+    std::vector<uint32_t> affectedNodes;
+    std::vector<std::pair<double, uint32_t> > heap;
+    
+    void rebuild(const CompactGraph& view);
+    void repair(const CompactGraph& view, const std::vector<WeightChange>& log, size_t first);
+    void relabel(uint32_t node, double dist, uint32_t from, uint32_t edge);
+    void propagate(const CompactGraph& view);
+    
+public:
+    ShortestPathTree();
+    
+    // Full Dijkstra from source - O((V+E) log V)
+    void build(const Graph& graph, uint32_t sourceNode);
+    
+    // Brings the tree up to date with the graph. O(affected region) for weight
+    // changes; a topology change (new room or corridor), or changes trimmed
+    // from the log before the tree read them, force a rebuild.
+    void synchronize(const Graph& graph);
+    bool isSynchronized(const Graph& graph) const;
+    uint64_t getLogPosition() const { return logPosition; }
+    
+    uint32_t getSource() const { return source; }
+    double distanceTo(uint32_t node) const { return distance[node]; }
+    std::vector<uint32_t> pathTo(uint32_t node) const;     // empty if unreachable
+    
+    // Nodes whose label changed in the last build or repair
+    size_t getLastRelabelledCount() const { return lastRelabelled; }
+};
+
+#endif // SHORTEST_PATH_TREE_HPP
@@ -5,38 +5,103 @@
 #include "HospitalRoom.hpp"
 #include "MedicalStaff.hpp"
 #include "../data_structures/TriageQueue.hpp"
-#include "../data_structures/StateStack.hpp"
-#include "../data_structures/PatientState.hpp"
+#include "../data_structures/UndoJournal.hpp"
+#include "../data_structures/FlatHashMap.hpp"
+#include "../utils/WriteAheadLog.hpp"
 #include "../algorithms/Graph.hpp"
 #include "../algorithms/DijkstraRouter.hpp"
 #include "../algorithms/MSTGenerator.hpp"
 #include "../utils/Simulation.hpp"
 
 #include <vector>
-#include <unordered_map>
+#include <string>
 #include <memory>
+#include <thread>
 
 class EmergencyResponseSystem {
 private:
+    // Operations kept for undo; entries are 16-byte deltas on a ring buffer
+    static const size_t UNDO_DEPTH = 100000;
+    
     // Core components
     TriageQueue triageSystem;
-    StateStack<PatientState> undoSystem;
+    UndoJournal undoSystem;
     
     // Hospital infrastructure
     Graph hospitalLayout;
     std::unique_ptr<DijkstraRouter> staffRouter;
+    RouteInfo dispatchRoute;        // reused by every staff dispatch, so its path never reallocates
     std::unique_ptr<MSTGenerator> equipmentDistributor;
     
-    // Registries
-    std::unordered_map<std::string, Patient> patientRegistry;
-    std::unordered_map<std::string, HospitalRoom> roomRegistry;
-    std::unordered_map<std::string, MedicalStaff> staffRegistry;
+    // Registries (flat: an insert never allocates a node, and a lookup
+    // reads one control group before touching any entry)
+    FlatHashMap<PatientId, Patient> patientRegistry;
+    FlatHashMap<LocationId, HospitalRoom> roomRegistry;
+    FlatHashMap<StaffId, MedicalStaff> staffRegistry;
     
     // System state
     bool systemInitialized;
     int totalPatientsRegistered;
     int totalStaffAssignments;
-
+    
+    // Durability: every operation is appended here once a journal is open
+    enum class JournalRecord : uint8_t {
+        PATIENT_REGISTERED = 1,
+        PATIENTS_BATCH_REGISTERED,
+        PATIENT_TREATED,
+        STAFF_ASSIGNED,
+        VITALS_UPDATED,
+        PATIENT_TRANSFERRED,
+        OPERATION_UNDONE,
+        CORRIDOR_CLOSED,
+        CORRIDOR_REOPENED
+    };
+    std::unique_ptr<WriteAheadLog> journal;
+    RecordWriter journalRecord;     // scratch for single-operation records, reused the same way
+    // Records in the journal so far, replayed or appended. Snapshots store
+    // it so recovery can skip the operations a snapshot already holds.
+    uint64_t journalPosition;
+    void appendToJournal(JournalRecord type, const RecordWriter& record);
+    
+    // Snapshots are checksummed and written here, so intake only waits for
+    // the in-memory encoding. Once the file is in place the journal drops
+    // the records before mark, which the snapshot now holds.
+    static const uint32_t SNAPSHOT_VERSION = 3;
+    std::thread snapshotWriter;
+    std::string snapshotFailure;        // set by the writer, read after it is joined
+    void writeSnapshotFile(std::string path, std::vector<char> bytes,
+                           WriteAheadLog* coveredJournal, WriteAheadLog::Mark mark);
+    void encodeSnapshot(RecordWriter& body) const;
+    
+    // Router and MST generator over the current hospitalLayout
+    void attachRouting();
+    
+    // Journals and applies a corridor change only if it changes anything;
+    // false if no corridor joins the rooms
+    bool changeCorridorState(const LocationId& room1, const LocationId& room2, bool open);
+    
+    // State changes without console output or journaling, shared by the
+    // public operations and journal replay
+    void applyRegistration(const Patient& patient);
+    void applyBatchRegistration(const std::vector<Patient>& admitted);
+    void applyTreatment(const PatientId& patientID);      // patient already dequeued
+    void applyStaffAssignment(MedicalStaff& staff, const PatientId& patientID);
+    void applyVitalsUpdate(Patient& patient, const VitalSigns& vitals);
+    void applyTransfer(Patient& patient, const LocationId& location);
+    bool applyCorridorState(const LocationId& room1, const LocationId& room2, bool open);
+    void rollbackLastOperation();
+    void replayRecord(uint8_t type, RecordReader& payload);
+    
+    static void writeVitals(RecordWriter& record, const VitalSigns& vitals);
+    static VitalSigns readVitals(RecordReader& record);
+    static void writePatient(RecordWriter& record, const Patient& patient);
+    static Patient readPatient(RecordReader& record);
+    
+    // Keeps the triage copy of a waiting patient in step with the registry
+    void refreshQueuedPatient(const Patient& patient);
+    // Puts back a registration that undo found overwritten
+    void restoreRegistration(const ReplacedRegistration& replaced);
+    
 public:
     EmergencyResponseSystem();
     ~EmergencyResponseSystem();
@@ -48,17 +113,52 @@ public:
     
     // Emergency operations
     void registerNewPatient(const Patient& patient);                            // O(log n)
-    void assignStaffToPatient(const std::string& staffID, const std::string& patientID);
+    // Mass-casualty admission: one validation pass, one heapify, one undo entry.
+    // Returns how many patients were admitted.
+    int registerPatientsBatch(const std::vector<Patient>& patients);            // O(n + m)
+    void assignStaffToPatient(const StaffId& staffID, const PatientId& patientID);
     Patient processNextCriticalPatient();                                       // O(log n)
+    bool updatePatientVitals(const PatientId& patientID, const VitalSigns& vitals);   // O(log n)
+    bool transferPatient(const PatientId& patientID, const LocationId& location);    // O(log n)
     
     // Resource optimization
     void optimizeEquipmentDistribution();                                       // O(E log E)
-    RouteInfo findFastestRoute(const std::string& from, const std::string& to); // O((V+E) log V)
+    RouteInfo findFastestRoute(const LocationId& from, const LocationId& to); // O((V+E) log V)
+    
+    // Corridor closures, both directions; routes from ENTRANCE/ER repair locally.
+    // False if no corridor joins the rooms; repeating a close or reopen is a no-op.
+    bool closeCorridor(const LocationId& room1, const LocationId& room2);
+    bool reopenCorridor(const LocationId& room1, const LocationId& room2);
     
-    // Undo functionality
-    void undoLastOperation();                                                   // O(1)
+    // Crash recovery: replays the journal at path (if any) to rebuild the
+    // registries, triage queue and undo history, then appends every later
+    // operation to it. Call on a fresh system, or right after loadSnapshot to
+    // replay only what follows the snapshot. Returns the operations replayed.
+    size_t openJournal(const std::string& path, unsigned commitIntervalMicros = 2000);
+    void syncJournal();         // blocks until every journaled operation is on disk
+    
+    // Point-in-time snapshots for fast restart. saveSnapshot encodes the
+    // layout, registries and triage order in memory - the only pause for
+    // intake - and a background thread writes, syncs and renames the file
+    // into place. The undo history is saved with the rest, so after a
+    // restart from snapshot plus journal, undo reaches operations from
+    // before the snapshot exactly as it would have without the restart.
+    // Once the snapshot is on disk the journal starts over from it, so the
+    // journal alone no longer recovers the system. loadSnapshot maps the
+    // file and replaces all state; call it before openJournal, which then
+    // replays only the operations that came after.
+    size_t saveSnapshot(const std::string& path);      // O(n); returns the snapshot size in bytes
+    void waitForSnapshot();     // blocks until the last snapshot is on disk; throws if writing failed
+    void loadSnapshot(const std::string& path);        // O(n)
+    
+    // Undo functionality: rolls back the newest undo entry
+    void undoLastOperation();                                                   // O(log n), batches O(m log n)
     bool canUndo() const { return !undoSystem.isEmpty(); }
     
+    // Room for this many registrations in all, so a surge does not pay for
+    // registry rebuilds mid-intake. O(n)
+    void reservePatientCapacity(size_t patients);
+    
     // Reporting
     void generatePerformanceReport() const;
     void displaySystemStatus() const;
@@ -70,6 +170,12 @@ public:
     // Getters
     int getTotalPatientsRegistered() const { return totalPatientsRegistered; }
     int getPendingPatients() const { return triageSystem.getPendingCount(); }
+    int getTotalStaffAssignments() const { return totalStaffAssignments; }
+    int getTotalPatientsProcessed() const { return triageSystem.getTotalProcessed(); }
+    size_t getUndoDepth() const { return UNDO_DEPTH; }
+    const Patient* findPatient(const PatientId& patientID) const;   // nullptr if unknown
+    const MedicalStaff* findStaff(const StaffId& staffID) const;  // nullptr if unknown
+    bool isPatientWaiting(const PatientId& patientID) const { return triageSystem.contains(patientID); }
 };
 
 #endif // EMERGENCY_RESPONSE_SYSTEM_HPP
\ No newline at end of file
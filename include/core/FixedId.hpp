@@ -0,0 +1,114 @@
+#ifndef FIXED_ID_HPP
+#define FIXED_ID_HPP
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <functional>
+
+// Identifier of up to 31 characters stored inline in 32 bytes: copying,
+// hashing and comparing never touch the heap. The tag keeps patient, staff
+// and location IDs from being mixed up.
+//
+// Unused bytes are zero and the last byte holds MAX_LENGTH - length, so a
+// full-length ID ends in its own terminating NUL and equality is a single
+// 32-byte compare.
+template <typename Tag>
+class FixedId {
+public:
+    static const size_t MAX_LENGTH = 31;
+    
+private:
+    char chars[MAX_LENGTH + 1];
+    
+    void assign(const char* text, size_t length) {
+        if (length > MAX_LENGTH) {
+            throw std::length_error("ID longer than 31 characters: " + std::string(text, length));
+        }
+        std::memset(chars, 0, sizeof(chars));
+        std::memcpy(chars, text, length);
+        chars[MAX_LENGTH] = static_cast<char>(MAX_LENGTH - length);
+    }
+    
+public:
+    // Implicit from text so literals and strings read as IDs; throws
+    // std::length_error past MAX_LENGTH
+    FixedId() { assign("", 0); }
+    FixedId(const char* text) { assign(text, std::strlen(text)); }
+    FixedId(const std::string& text) { assign(text.data(), text.size()); }
+    // Same characters under another tag; explicit so kinds only mix on purpose
+    template <typename OtherTag>
+    explicit FixedId(const FixedId<OtherTag>& other) { std::memcpy(chars, other.data(), sizeof(chars)); }
+    
+    size_t size() const { return MAX_LENGTH - static_cast<unsigned char>(chars[MAX_LENGTH]); }
+    size_t length() const { return size(); }
+    bool empty() const { return chars[0] == '\0'; }
+    const char* c_str() const { return chars; }
+    const char* data() const { return chars; }
+    char operator[](size_t index) const { return chars[index]; }
+    
+    std::string str() const { return std::string(chars, size()); }
+    operator std::string() const { return str(); }
+    
+    bool operator==(const FixedId& other) const { return std::memcmp(chars, other.chars, sizeof(chars)) == 0; }
+    bool operator!=(const FixedId& other) const { return !(*this == other); }
+    // Same order as the strings: padding is zero and IDs hold no NUL
+    bool operator<(const FixedId& other) const { return std::memcmp(chars, other.chars, MAX_LENGTH) < 0; }
+    
+    // FNV-1a over the characters
+    size_t hash() const {
+        size_t value = static_cast<size_t>(14695981039346656037ULL);
+        for (size_t i = 0; i < MAX_LENGTH && chars[i]; i++) {
+            value = (value ^ static_cast<unsigned char>(chars[i])) * static_cast<size_t>(1099511628211ULL);
+        }
+        return value;
+    }
+};
+
+template <typename Tag>
+const size_t FixedId<Tag>::MAX_LENGTH;
+
+// Comparisons with text, without building a temporary ID
+template <typename Tag>
+bool operator==(const FixedId<Tag>& id, const std::string& text) {
+    return id.size() == text.size() && std::memcmp(id.data(), text.data(), text.size()) == 0;
+}
+template <typename Tag>
+bool operator==(const std::string& text, const FixedId<Tag>& id) { return id == text; }
+template <typename Tag>
+bool operator!=(const FixedId<Tag>& id, const std::string& text) { return !(id == text); }
+template <typename Tag>
+bool operator!=(const std::string& text, const FixedId<Tag>& id) { return !(id == text); }
+
+template <typename Tag>
+bool operator==(const FixedId<Tag>& id, const char* text) { return std::strcmp(id.c_str(), text) == 0; }
+template <typename Tag>
+bool operator==(const char* text, const FixedId<Tag>& id) { return id == text; }
+template <typename Tag>
+bool operator!=(const FixedId<Tag>& id, const char* text) { return !(id == text); }
+template <typename Tag>
+bool operator!=(const char* text, const FixedId<Tag>& id) { return !(id == text); }
+
+template <typename Tag>
+std::ostream& operator<<(std::ostream& os, const FixedId<Tag>& id) {
+    return os << id.c_str();     // honours setw like any C string
+}
+
+namespace std {
+template <typename Tag>
+struct hash<FixedId<Tag> > {
+    size_t operator()(const FixedId<Tag>& id) const { return id.hash(); }
+};
+}
+
+struct PatientIdTag {};
+struct StaffIdTag {};
+struct LocationIdTag {};
+
+typedef FixedId<PatientIdTag> PatientId;
+typedef FixedId<StaffIdTag> StaffId;
+typedef FixedId<LocationIdTag> LocationId;      // rooms and graph nodes
+
+#endif // FIXED_ID_HPP
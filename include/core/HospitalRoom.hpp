@@ -1,6 +1,7 @@
 #ifndef HOSPITAL_ROOM_HPP
 #define HOSPITAL_ROOM_HPP
 
+#include "FixedId.hpp"
 #include <string>
 #include <vector>
 
@@ -23,26 +24,27 @@ struct Coordinates {
 
 class HospitalRoom {
 private:
-    std::string roomID;
+    LocationId roomID;
     RoomType type;
     Coordinates position;
     std::vector<std::string> equipment;
     bool occupied;
     int capacity;
     int currentOccupancy;
-
+    
 public:
     // Constructor
     HospitalRoom();
-    HospitalRoom(const std::string& id, RoomType t, Coordinates pos, int cap);
+    HospitalRoom(const LocationId& id, RoomType t, Coordinates pos, int cap);
     
     // Getters
-    std::string getRoomID() const { return roomID; }
+    const LocationId& getRoomID() const { return roomID; }
     RoomType getType() const { return type; }
     Coordinates getPosition() const { return position; }
     bool isOccupied() const { return occupied; }
     int getCapacity() const { return capacity; }
     int getCurrentOccupancy() const { return currentOccupancy; }
+    const std::vector<std::string>& getEquipment() const { return equipment; }
     
     // Room management
     bool addEquipment(const std::string& equipmentName);
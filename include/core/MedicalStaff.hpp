@@ -1,6 +1,7 @@
 #ifndef MEDICAL_STAFF_HPP
 #define MEDICAL_STAFF_HPP
 
+#include "FixedId.hpp"
 #include <string>
 
 enum class StaffRole {
@@ -21,30 +22,30 @@ enum class AvailabilityStatus {
 
 class MedicalStaff {
 private:
-    std::string staffID;
+    StaffId staffID;
     std::string name;
     StaffRole role;
-    std::string currentLocation;
+    LocationId currentLocation;
     AvailabilityStatus status;
-    std::string assignedPatientID;
-
+    PatientId assignedPatientID;
+    
 public:
     // Constructor
     MedicalStaff();
-    MedicalStaff(const std::string& id, const std::string& staffName, StaffRole r);
+    MedicalStaff(const StaffId& id, const std::string& staffName, StaffRole r);
     
     // Getters
-    std::string getStaffID() const { return staffID; }
-    std::string getName() const { return name; }
+    const StaffId& getStaffID() const { return staffID; }
+    const std::string& getName() const { return name; }
     StaffRole getRole() const { return role; }
-    std::string getCurrentLocation() const { return currentLocation; }
+    const LocationId& getCurrentLocation() const { return currentLocation; }
     AvailabilityStatus getStatus() const { return status; }
-    std::string getAssignedPatientID() const { return assignedPatientID; }
+    const PatientId& getAssignedPatientID() const { return assignedPatientID; }
     
     // Setters
-    void setCurrentLocation(const std::string& loc) { currentLocation = loc; }
+    void setCurrentLocation(const LocationId& loc) { currentLocation = loc; }
     void setStatus(AvailabilityStatus s) { status = s; }
-    void assignToPatient(const std::string& patientID);
+    void assignToPatient(const PatientId& patientID);
     void clearAssignment();
     
     // Display
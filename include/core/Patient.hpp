@@ -1,6 +1,7 @@
 #ifndef PATIENT_HPP
 #define PATIENT_HPP
 
+#include "FixedId.hpp"
 #include <string>
 #include <ctime>
 #include <iostream>
@@ -24,43 +25,56 @@ struct VitalSigns {
 };
 
 class Patient {
+public:
+    // Waiting escalation: one severity point per this many seconds waited
+    static const int SECONDS_PER_SEVERITY_POINT = 600;
+    
 private:
-    std::string patientID;
+    PatientId patientID;
     int severityScore;
     time_t arrivalTime;
-    std::string location;
+    LocationId location;
     VitalSigns vitalSigns;
     TriageStatus status;
-
+    
 public:
     // Constructors
     Patient();
-    Patient(const std::string& id, const VitalSigns& vitals, const std::string& loc);
+    Patient(const PatientId& id, const VitalSigns& vitals, const LocationId& loc);
     
-    // Getters
-    std::string getPatientID() const { return patientID; }
+    // Getters (IDs are inline; references never allocate)
+    const PatientId& getPatientID() const { return patientID; }
     int getSeverityScore() const { return severityScore; }
     time_t getArrivalTime() const { return arrivalTime; }
-    std::string getLocation() const { return location; }
-    VitalSigns getVitalSigns() const { return vitalSigns; }
+    const LocationId& getLocation() const { return location; }
+    const VitalSigns& getVitalSigns() const { return vitalSigns; }
     TriageStatus getStatus() const { return status; }
     
     // Setters
-    void setLocation(const std::string& loc) { location = loc; }
+    void setLocation(const LocationId& loc) { location = loc; }
     void setStatus(TriageStatus s) { status = s; }
     void setVitalSigns(const VitalSigns& vitals);
+    void setArrivalTime(time_t arrival) { arrivalTime = arrival; updateSeverity(); }
     
     // Core functionality
     int calculateSeverity() const;  // Complexity: O(1)
+    int calculateSeverityAt(time_t now) const;
+    // Vital-sign score before waiting time and the clamp to 0 (-5..100)
+    int calculateBaseSeverity() const { return baseSeverityOf(vitalSigns); }
     void updateSeverity();
     
+    // The scoring rules, shared with PatientColumns' batch scorer
+    static int baseSeverityOf(const VitalSigns& vitals);
+    static int agedSeverity(int baseSeverity, time_t arrival, time_t now);
+    void updateSeverityAt(time_t now) { severityScore = calculateSeverityAt(now); }
+    
     // Comparison operator for heap
     bool operator>(const Patient& other) const {
-        return severityScore < other.severityScore; // Lower score = higher priority
+        return severityScore > other.severityScore;
     }
     
     bool operator<(const Patient& other) const {
-        return severityScore > other.severityScore;
+        return severityScore < other.severityScore; // Lower score = higher priority
     }
     
     // Display
@@ -0,0 +1,77 @@
+#ifndef CONCURRENT_TRIAGE_QUEUE_HPP
+#define CONCURRENT_TRIAGE_QUEUE_HPP
+
+#include "MinHeap.hpp"
+#include "../core/Patient.hpp"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+// Thread-safe triage queue for many intake desks and many consumers.
+//
+// A MultiQueue: S independently locked 4-ary heaps (shards). Producers push
+// to a random shard whose lock they can get without waiting. Consumers look
+// at the cached top key of two random shards, take the better one and pop
+// it. Nothing is ever globally locked, so throughput scales with threads.
+//
+// Priority is relaxed. A consumer may get a patient who is not the most
+// critical one waiting. The rank error (how many waiting patients are more
+// urgent than the one returned) has an expected value of O(S) with
+// two-choice selection, and is O(S log S) with high probability. With the
+// default S = 2 * hardware threads, that is a handful of places in a queue
+// of thousands. Relaxation only reorders patients - none is ever lost or
+// handed out twice. Equal severities are FIFO within a shard and roughly
+// FIFO overall.
+class ConcurrentTriageQueue {
+private:
+    static const uint64_t EMPTY_KEY = ~0ULL;
+    
+    struct Entry {
+        uint64_t key;           // severity << 48 | arrival sequence
+        Patient patient;
+        
+        Entry() : key(EMPTY_KEY) {}
+        Entry(uint64_t k, const Patient& p) : key(k), patient(p) {}
+        
+        bool operator<(const Entry& other) const { return key < other.key; }
+    };
+    
+    struct Shard {
+        std::mutex lock;
+        MinHeap<Entry, 4> heap;
+        std::atomic<uint64_t> topKey;   // key of heap.getMin(), EMPTY_KEY when empty
+        char padding[64];               // keep neighbouring shards' hot words apart
+        
+        Shard() : topKey(EMPTY_KEY) {}
+        void refreshTop() {
+            topKey.store(heap.isEmpty() ? EMPTY_KEY : heap.getMin().key,
+                         std::memory_order_release);
+        }
+    };
+    
+    std::vector<std::unique_ptr<Shard> > shards;
+    std::atomic<uint64_t> nextArrival;
+    std::atomic<int> pendingCount;
+    std::atomic<int> processedCount;
+    
+    size_t randomShard() const;
+    bool popFrom(Shard& shard, Patient& patient);
+    
+public:
+    // shardCount 0 uses two shards per hardware thread (at least 4)
+    explicit ConcurrentTriageQueue(unsigned shardCount = 0);
+    
+    // Safe to call from any number of threads at once
+    void addPatient(const Patient& patient);            // O(log(n/S)) expected
+    bool tryGetNextPatient(Patient& patient);           // false once the queue is empty
+    
+    // Approximate while producers or consumers are running
+    int getPendingCount() const { return pendingCount.load(std::memory_order_relaxed); }
+    bool isEmpty() const { return getPendingCount() == 0; }
+    int getTotalProcessed() const { return processedCount.load(std::memory_order_relaxed); }
+    size_t getShardCount() const { return shards.size(); }
+};
+
+#endif // CONCURRENT_TRIAGE_QUEUE_HPP
@@ -0,0 +1,420 @@
+#ifndef FLAT_HASH_MAP_HPP
+#define FLAT_HASH_MAP_HPP
+
+#include <vector>
+#include <utility>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <new>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2 1
+#endif
+
+// Open-addressing hash map in the SwissTable layout. Entries sit in one
+// flat slot array and a parallel array holds one control byte per slot:
+// EMPTY, DELETED, or the low 7 bits of the key's hash. A lookup hashes once,
+// then scans the control bytes 16 at a time (one SSE2 compare where
+// available, a plain loop otherwise) and only touches slots whose byte
+// matches, so most misses never read a key.
+//
+// Unlike std::unordered_map, inserting may move every entry: iterators,
+// pointers and references are invalidated by any insert that grows the
+// table. Erase frees the slot outright when no probe can have passed it,
+// and otherwise leaves a DELETED marker that later inserts reuse; the table
+// is rebuilt once markers and entries fill 7/8 of it. Keys must not be
+// modified through an iterator.
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K> >
+class FlatHashMap {
+public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef std::pair<K, V> value_type;
+    
+    static const size_t GROUP_WIDTH = 16;
+    
+private:
+    static const int8_t EMPTY = -128;       // 0b10000000
+    static const int8_t DELETED = -2;       // 0b11111110; full bytes are 0..127
+    
+    // Control bytes of GROUP_WIDTH consecutive slots
+    struct Group {
+        const int8_t* ctrl;
+        explicit Group(const int8_t* position) : ctrl(position) {}
+        uint32_t match(int8_t tag) const;           // bit i set: slot i holds tag
+        uint32_t matchEmpty() const;
+        uint32_t matchFree() const;                 // EMPTY or DELETED
+    };
+    
+    value_type* slots;
+    int8_t* ctrl;           // capacity + GROUP_WIDTH bytes; the tail mirrors the first group
+    size_t capacityMask;    // capacity - 1; 0 while unallocated
+    size_t entryCount;
+    size_t growthLeft;      // inserts into EMPTY slots before a rebuild
+    Hash hasher;
+    KeyEqual equal;
+    
+    size_t capacity() const { return capacityMask ? capacityMask + 1 : 0; }
+    static size_t maxLoad(size_t capacity) { return capacity - capacity / 8; }
+    static size_t mix(size_t hash);
+    static int8_t tagOf(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+    static int countTrailingZeros(uint32_t bits);
+    static int countLeadingZeros(uint32_t bits);
+    
+    void setCtrl(size_t index, int8_t value);
+    size_t findIndex(const K& key) const;           // capacity() if absent
+    size_t findFreeSlot(size_t hash) const;
+    void rehash(size_t newCapacity);
+    void release();
+    template<typename P> std::pair<size_t, bool> insertUnique(P&& entry);
+    
+public:
+    template<bool Const>
+    class Iterator {
+        friend class FlatHashMap;
+        template<bool> friend class Iterator;
+        typedef typename std::conditional<Const, const FlatHashMap*, FlatHashMap*>::type MapPointer;
+        MapPointer map;
+        size_t index;
+        
+        Iterator(MapPointer owner, size_t position) : map(owner), index(position) { skipFree(); }
+        void skipFree() {
+            while (index < map->capacity() && map->ctrl[index] < 0) index++;
+        }
+    
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename FlatHashMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const value_type&, value_type&>::type reference;
+        typedef typename std::conditional<Const, const value_type*, value_type*>::type pointer;
+        
+        Iterator() : map(nullptr), index(0) {}
+        // iterator converts to const_iterator
+        template<bool WasConst, typename = typename std::enable_if<Const && !WasConst>::type>
+        Iterator(const Iterator<WasConst>& other) : map(other.map), index(other.index) {}
+        
+        reference operator*() const { return map->slots[index]; }
+        pointer operator->() const { return &map->slots[index]; }
+        Iterator& operator++() { index++; skipFree(); return *this; }
+        Iterator operator++(int) { Iterator before = *this; ++*this; return before; }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    
+    FlatHashMap() : slots(nullptr), ctrl(nullptr), capacityMask(0), entryCount(0), growthLeft(0) {}
+    FlatHashMap(const FlatHashMap& other);
+    FlatHashMap(FlatHashMap&& other);
+    FlatHashMap& operator=(FlatHashMap other) { swap(other); return *this; }
+    ~FlatHashMap() { release(); }
+    
+    // Lookup: O(1) expected
+    iterator find(const K& key) { return iterator(this, findIndex(key)); }
+    const_iterator find(const K& key) const { return const_iterator(this, findIndex(key)); }
+    size_t count(const K& key) const { return findIndex(key) < capacity() ? 1 : 0; }
+    
+    // Insertion: O(1) amortized. insert keeps an existing entry unchanged.
+    std::pair<iterator, bool> insert(const value_type& entry);
+    std::pair<iterator, bool> insert(value_type&& entry);
+    V& operator[](const K& key);
+    
+    size_t erase(const K& key);                     // O(1) expected; returns 0 or 1
+    void clear();                                   // keeps the allocation
+    void reserve(size_t entries);                   // room for entries without a rebuild
+    void swap(FlatHashMap& other);
+    
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, capacity()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, capacity()); }
+    
+    size_t size() const { return entryCount; }
+    bool empty() const { return entryCount == 0; }
+    size_t bucket_count() const { return capacity(); }
+    // Slot array plus control bytes
+    size_t memoryUsage() const { return capacity() ? capacity() * sizeof(value_type) + capacity() + GROUP_WIDTH : 0; }
+};
+
+// Template implementation
+
+template<typename K, typename V, typename H, typename E>
+const size_t FlatHashMap<K, V, H, E>::GROUP_WIDTH;
+template<typename K, typename V, typename H, typename E>
+const int8_t FlatHashMap<K, V, H, E>::EMPTY;
+template<typename K, typename V, typename H, typename E>
+const int8_t FlatHashMap<K, V, H, E>::DELETED;
+
+#ifdef FLAT_HASH_MAP_SSE2
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::match(int8_t tag) const {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), bytes)));
+}
+
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::matchEmpty() const {
+    return match(EMPTY);
+}
+
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::matchFree() const {
+    // EMPTY and DELETED are the only bytes below -1
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), bytes)));
+}
+#else
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::match(int8_t tag) const {
+    uint32_t bits = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] == tag) bits |= 1u << i;
+    }
+    return bits;
+}
+
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::matchEmpty() const {
+    return match(EMPTY);
+}
+
+template<typename K, typename V, typename H, typename E>
+uint32_t FlatHashMap<K, V, H, E>::Group::matchFree() const {
+    uint32_t bits = 0;
+    for (size_t i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] < -1) bits |= 1u << i;
+    }
+    return bits;
+}
+#endif
+
+template<typename K, typename V, typename H, typename E>
+int FlatHashMap<K, V, H, E>::countTrailingZeros(uint32_t bits) {
+#if defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else
+    int zeros = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        zeros++;
+    }
+    return zeros;
+#endif
+}
+
+// Of the GROUP_WIDTH bits a group match can set
+template<typename K, typename V, typename H, typename E>
+int FlatHashMap<K, V, H, E>::countLeadingZeros(uint32_t bits) {
+    int zeros = 0;
+    for (uint32_t bit = 1u << (GROUP_WIDTH - 1); bit && !(bits & bit); bit >>= 1) {
+        zeros++;
+    }
+    return zeros;
+}
+
+// Spreads weak hashes (e.g. identity hashes of integers) over every bit,
+// since the slot comes from the high bits and the tag from the low ones
+template<typename K, typename V, typename H, typename E>
+size_t FlatHashMap<K, V, H, E>::mix(size_t hash) {
+    uint64_t x = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(x ^ (x >> 32));
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::setCtrl(size_t index, int8_t value) {
+    ctrl[index] = value;
+    if (index < GROUP_WIDTH) {
+        ctrl[capacity() + index] = value;   // keep the mirrored group in step
+    }
+}
+
+// Groups are probed at triangular offsets (16, 48, 96, ... slots on), which
+// visits every group of a power-of-two table exactly once
+template<typename K, typename V, typename H, typename E>
+size_t FlatHashMap<K, V, H, E>::findIndex(const K& key) const {
+    if (entryCount == 0) return capacity();
+    size_t hash = mix(hasher(key));
+    int8_t tag = tagOf(hash);
+    size_t position = (hash >> 7) & capacityMask;
+    for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+        Group group(ctrl + position);
+        for (uint32_t bits = group.match(tag); bits; bits &= bits - 1) {
+            size_t index = (position + countTrailingZeros(bits)) & capacityMask;
+            if (equal(slots[index].first, key)) return index;
+        }
+        if (group.matchEmpty()) return capacity();
+        position = (position + step) & capacityMask;
+    }
+}
+
+template<typename K, typename V, typename H, typename E>
+size_t FlatHashMap<K, V, H, E>::findFreeSlot(size_t hash) const {
+    size_t position = (hash >> 7) & capacityMask;
+    for (size_t step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+        uint32_t bits = Group(ctrl + position).matchFree();
+        if (bits) return (position + countTrailingZeros(bits)) & capacityMask;
+        position = (position + step) & capacityMask;
+    }
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::rehash(size_t newCapacity) {
+    value_type* oldSlots = slots;
+    int8_t* oldCtrl = ctrl;
+    size_t oldCapacity = capacity();
+    
+    slots = static_cast<value_type*>(::operator new(newCapacity * sizeof(value_type)));
+    ctrl = new int8_t[newCapacity + GROUP_WIDTH];
+    for (size_t i = 0; i < newCapacity + GROUP_WIDTH; i++) ctrl[i] = EMPTY;
+    capacityMask = newCapacity - 1;
+    growthLeft = maxLoad(newCapacity) - entryCount;
+    
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] < 0) continue;
+        size_t hash = mix(hasher(oldSlots[i].first));
+        size_t index = findFreeSlot(hash);
+        new (&slots[index]) value_type(std::move(oldSlots[i]));
+        setCtrl(index, tagOf(hash));
+        oldSlots[i].~value_type();
+    }
+    ::operator delete(oldSlots);
+    delete[] oldCtrl;
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::release() {
+    for (size_t i = 0; i < capacity(); i++) {
+        if (ctrl[i] >= 0) slots[i].~value_type();
+    }
+    ::operator delete(slots);
+    delete[] ctrl;
+    slots = nullptr;
+    ctrl = nullptr;
+    capacityMask = 0;
+    entryCount = 0;
+    growthLeft = 0;
+}
+
+template<typename K, typename V, typename H, typename E>
+template<typename P>
+std::pair<size_t, bool> FlatHashMap<K, V, H, E>::insertUnique(P&& entry) {
+    size_t existing = findIndex(entry.first);
+    if (existing < capacity()) {
+        return std::make_pair(existing, false);
+    }
+    
+    size_t hash = mix(hasher(entry.first));
+    size_t index = capacity() ? findFreeSlot(hash) : 0;
+    if (!capacity() || (growthLeft == 0 && ctrl[index] == EMPTY)) {
+        // Out of EMPTY slots: grow, or just sweep out the DELETED markers
+        // when they are what filled the table
+        size_t target = capacity() ? capacity() : GROUP_WIDTH;
+        if (entryCount + 1 > maxLoad(target) / 2) target *= 2;
+        rehash(target);
+        index = findFreeSlot(hash);
+    }
+    
+    new (&slots[index]) value_type(std::forward<P>(entry));
+    if (ctrl[index] == EMPTY) growthLeft--;
+    setCtrl(index, tagOf(hash));
+    entryCount++;
+    return std::make_pair(index, true);
+}
+
+template<typename K, typename V, typename H, typename E>
+FlatHashMap<K, V, H, E>::FlatHashMap(const FlatHashMap& other)
+    : slots(nullptr), ctrl(nullptr), capacityMask(0), entryCount(0), growthLeft(0),
+      hasher(other.hasher), equal(other.equal) {
+    reserve(other.entryCount);
+    for (const value_type& entry : other) {
+        insertUnique(entry);
+    }
+}
+
+template<typename K, typename V, typename H, typename E>
+FlatHashMap<K, V, H, E>::FlatHashMap(FlatHashMap&& other)
+    : slots(nullptr), ctrl(nullptr), capacityMask(0), entryCount(0), growthLeft(0) {
+    swap(other);
+}
+
+template<typename K, typename V, typename H, typename E>
+std::pair<typename FlatHashMap<K, V, H, E>::iterator, bool>
+FlatHashMap<K, V, H, E>::insert(const value_type& entry) {
+    std::pair<size_t, bool> result = insertUnique(entry);
+    return std::make_pair(iterator(this, result.first), result.second);
+}
+
+template<typename K, typename V, typename H, typename E>
+std::pair<typename FlatHashMap<K, V, H, E>::iterator, bool>
+FlatHashMap<K, V, H, E>::insert(value_type&& entry) {
+    std::pair<size_t, bool> result = insertUnique(std::move(entry));
+    return std::make_pair(iterator(this, result.first), result.second);
+}
+
+template<typename K, typename V, typename H, typename E>
+V& FlatHashMap<K, V, H, E>::operator[](const K& key) {
+    size_t index = findIndex(key);
+    if (index == capacity()) {
+        index = insertUnique(value_type(key, V())).first;
+    }
+    return slots[index].second;
+}
+
+template<typename K, typename V, typename H, typename E>
+size_t FlatHashMap<K, V, H, E>::erase(const K& key) {
+    size_t index = findIndex(key);
+    if (index == capacity()) return 0;
+    slots[index].~value_type();
+    entryCount--;
+    
+    // Lookups stop at the first group holding an EMPTY. If every group that
+    // covers this slot still has one, no probe ever ran past the slot and it
+    // can go straight back to EMPTY, so tables with steady churn never need
+    // a rebuild to clear markers
+    uint32_t emptyAfter = Group(ctrl + index).matchEmpty();
+    uint32_t emptyBefore = Group(ctrl + ((index - GROUP_WIDTH) & capacityMask)).matchEmpty();
+    if (emptyAfter && emptyBefore &&
+        countTrailingZeros(emptyAfter) + countLeadingZeros(emptyBefore) < static_cast<int>(GROUP_WIDTH)) {
+        setCtrl(index, EMPTY);
+        growthLeft++;
+    } else {
+        setCtrl(index, DELETED);
+    }
+    return 1;
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::clear() {
+    for (size_t i = 0; i < capacity(); i++) {
+        if (ctrl[i] >= 0) slots[i].~value_type();
+    }
+    for (size_t i = 0; i < capacity() + (capacity() ? GROUP_WIDTH : 0); i++) ctrl[i] = EMPTY;
+    entryCount = 0;
+    growthLeft = maxLoad(capacity());
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::reserve(size_t entries) {
+    if (entries <= entryCount + growthLeft && capacity()) return;
+    size_t target = capacity() ? capacity() : GROUP_WIDTH;
+    while (maxLoad(target) < entries) target *= 2;
+    rehash(target);         // same size when only DELETED markers were in the way
+}
+
+template<typename K, typename V, typename H, typename E>
+void FlatHashMap<K, V, H, E>::swap(FlatHashMap& other) {
+    std::swap(slots, other.slots);
+    std::swap(ctrl, other.ctrl);
+    std::swap(capacityMask, other.capacityMask);
+    std::swap(entryCount, other.entryCount);
+    std::swap(growthLeft, other.growthLeft);
+    std::swap(hasher, other.hasher);
+    std::swap(equal, other.equal);
+}
+
+#endif // FLAT_HASH_MAP_HPP
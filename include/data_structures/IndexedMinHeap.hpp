@@ -0,0 +1,298 @@
+#ifndef INDEXED_MIN_HEAP_HPP
+#define INDEXED_MIN_HEAP_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+// d-ary min-heap whose items are addressed by stable handles.
+// Items live inline in the heap array next to their handle, so sifting
+// compares contiguous memory; every handle knows its heap position, so an
+// item can be re-keyed or removed in O(log n) without searching for it.
+template<typename T, unsigned Arity = 4>
+class IndexedMinHeap {
+public:
+    typedef uint32_t Handle;
+    static const Handle INVALID_HANDLE = 0xFFFFFFFFu;
+    
+private:
+    static const size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+    
+    struct Entry {
+        T item;
+        Handle handle;
+        
+        Entry(const T& i, Handle h) : item(i), handle(h) {}
+    };
+    
+    std::vector<Entry> heap;            // heap order
+    std::vector<size_t> position;       // handle -> heap index, NOT_IN_HEAP if free
+    std::vector<Handle> freeHandles;    // recycled handles
+    
+    static size_t parent(size_t i) { return (i - 1) / Arity; }
+    static size_t firstChild(size_t i) { return Arity * i + 1; }
+    
+    void place(size_t index, Entry&& entry) {
+        position[entry.handle] = index;
+        heap[index] = std::move(entry);
+    }
+    
+    // Hole-based sifts: the moving entry is written once, at its final index
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+    void checkHandle(Handle handle) const;
+    
+public:
+    IndexedMinHeap() {}
+    
+    Handle insert(const T& item);                       // O(log n)
+    // Bulk insert, handles in batch order. Large batches are appended and
+    // heapified bottom-up in O(n + m) instead of m sifts of O(log n).
+    void insertBatch(const std::vector<T>& batch, std::vector<Handle>& handles);
+    T extractMin();                                     // O(d log n)
+    const T& getMin() const;                            // O(1)
+    Handle getMinHandle() const;                        // O(1)
+    
+    // Re-keying - O(log n). decreaseKey/increaseKey throw if the new key
+    // moves the wrong way; update accepts either direction.
+    void decreaseKey(Handle handle, const T& item);
+    void increaseKey(Handle handle, const T& item);
+    void update(Handle handle, const T& item);
+    T erase(Handle handle);                             // O(d log n)
+    
+    bool contains(Handle handle) const {
+        return handle < position.size() && position[handle] != NOT_IN_HEAP;
+    }
+    const T& get(Handle handle) const { checkHandle(handle); return heap[position[handle]].item; }
+    
+    bool isEmpty() const { return heap.empty(); }
+    int size() const { return static_cast<int>(heap.size()); }
+    void clear();
+    
+    // The k smallest items in order, without touching the heap - O(k log k)
+    std::vector<T> peekSmallest(size_t k) const;
+    
+    // Heap order, root first - for read-only walks of the tree
+    const T& itemAt(size_t index) const { return heap[index].item; }
+    Handle handleAt(size_t index) const { return heap[index].handle; }
+};
+
+template<typename T, unsigned Arity>
+const typename IndexedMinHeap<T, Arity>::Handle IndexedMinHeap<T, Arity>::INVALID_HANDLE;
+
+template<typename T, unsigned Arity>
+const size_t IndexedMinHeap<T, Arity>::NOT_IN_HEAP;
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::checkHandle(Handle handle) const {
+    if (!contains(handle)) {
+        throw std::out_of_range("Invalid heap handle!");
+    }
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::siftUp(size_t index) {
+    Entry moving = std::move(heap[index]);
+    while (index > 0) {
+        size_t up = parent(index);
+        if (!(moving.item < heap[up].item)) break;
+        place(index, std::move(heap[up]));
+        index = up;
+    }
+    place(index, std::move(moving));
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::siftDown(size_t index) {
+    Entry moving = std::move(heap[index]);
+    size_t count = heap.size();
+    while (true) {
+        size_t first = firstChild(index);
+        if (first >= count) break;
+        
+        size_t last = (first + Arity < count) ? first + Arity : count;
+        size_t best = first;
+        for (size_t child = first + 1; child < last; child++) {
+            if (heap[child].item < heap[best].item) best = child;
+        }
+        if (!(heap[best].item < moving.item)) break;
+        
+        place(index, std::move(heap[best]));
+        index = best;
+    }
+    place(index, std::move(moving));
+}
+
+template<typename T, unsigned Arity>
+typename IndexedMinHeap<T, Arity>::Handle IndexedMinHeap<T, Arity>::insert(const T& item) {
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+    } else {
+        handle = static_cast<Handle>(position.size());
+        position.push_back(NOT_IN_HEAP);
+    }
+    
+    heap.push_back(Entry(item, handle));
+    position[handle] = heap.size() - 1;
+    siftUp(heap.size() - 1);
+    return handle;
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::insertBatch(const std::vector<T>& batch, std::vector<Handle>& handles) {
+    handles.clear();
+    handles.reserve(batch.size());
+    if (batch.empty()) return;
+    
+    // m sifts cost about m log2(n + m); a rebuild touches every entry once
+    size_t total = heap.size() + batch.size();
+    size_t depth = 1;
+    while ((static_cast<size_t>(1) << depth) < total) depth++;
+    if (batch.size() * depth < total) {
+        for (const T& item : batch) {
+            handles.push_back(insert(item));
+        }
+        return;
+    }
+    
+    heap.reserve(total);
+    for (const T& item : batch) {
+        Handle handle;
+        if (!freeHandles.empty()) {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        } else {
+            handle = static_cast<Handle>(position.size());
+            position.push_back(NOT_IN_HEAP);
+        }
+        position[handle] = heap.size();
+        heap.push_back(Entry(item, handle));
+        handles.push_back(handle);
+    }
+    
+    if (heap.size() > 1) {
+        for (size_t i = parent(heap.size() - 1) + 1; i-- > 0; ) {
+            siftDown(i);
+        }
+    }
+}
+
+template<typename T, unsigned Arity>
+T IndexedMinHeap<T, Arity>::extractMin() {
+    if (isEmpty()) {
+        throw std::runtime_error("Heap is empty!");
+    }
+    return erase(heap[0].handle);
+}
+
+template<typename T, unsigned Arity>
+const T& IndexedMinHeap<T, Arity>::getMin() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Heap is empty!");
+    }
+    return heap[0].item;
+}
+
+template<typename T, unsigned Arity>
+typename IndexedMinHeap<T, Arity>::Handle IndexedMinHeap<T, Arity>::getMinHandle() const {
+    return isEmpty() ? INVALID_HANDLE : heap[0].handle;
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::decreaseKey(Handle handle, const T& item) {
+    checkHandle(handle);
+    Entry& entry = heap[position[handle]];
+    if (entry.item < item) {
+        throw std::invalid_argument("decreaseKey: new key is greater than current key");
+    }
+    entry.item = item;
+    siftUp(position[handle]);
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::increaseKey(Handle handle, const T& item) {
+    checkHandle(handle);
+    Entry& entry = heap[position[handle]];
+    if (item < entry.item) {
+        throw std::invalid_argument("increaseKey: new key is smaller than current key");
+    }
+    entry.item = item;
+    siftDown(position[handle]);
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::update(Handle handle, const T& item) {
+    checkHandle(handle);
+    Entry& entry = heap[position[handle]];
+    bool smaller = item < entry.item;
+    entry.item = item;
+    if (smaller) {
+        siftUp(position[handle]);
+    } else {
+        siftDown(position[handle]);
+    }
+}
+
+template<typename T, unsigned Arity>
+T IndexedMinHeap<T, Arity>::erase(Handle handle) {
+    checkHandle(handle);
+    size_t index = position[handle];
+    T removed = std::move(heap[index].item);
+    position[handle] = NOT_IN_HEAP;
+    freeHandles.push_back(handle);
+    
+    // Fill the hole with the last entry, then restore order in whichever
+    // direction that entry needs to go
+    if (index + 1 < heap.size()) {
+        place(index, std::move(heap.back()));
+        heap.pop_back();
+        if (index > 0 && heap[index].item < heap[parent(index)].item) {
+            siftUp(index);
+        } else {
+            siftDown(index);
+        }
+    } else {
+        heap.pop_back();
+    }
+    return removed;
+}
+
+template<typename T, unsigned Arity>
+std::vector<T> IndexedMinHeap<T, Arity>::peekSmallest(size_t k) const {
+    std::vector<T> smallest;
+    if (k == 0 || heap.empty()) return smallest;
+    smallest.reserve(k < heap.size() ? k : heap.size());
+    
+    // Frontier of heap indices whose parents have been emitted. The next
+    // smallest item is always on the frontier, and each emitted index adds
+    // at most Arity children, so it never grows beyond O(k).
+    auto later = [this](size_t a, size_t b) { return heap[b].item < heap[a].item; };
+    std::vector<size_t> frontier(1, 0);
+    while (!frontier.empty() && smallest.size() < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), later);
+        size_t index = frontier.back();
+        frontier.pop_back();
+        smallest.push_back(heap[index].item);
+        
+        size_t first = firstChild(index);
+        for (size_t child = first; child < first + Arity && child < heap.size(); child++) {
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), later);
+        }
+    }
+    return smallest;
+}
+
+template<typename T, unsigned Arity>
+void IndexedMinHeap<T, Arity>::clear() {
+    heap.clear();
+    position.clear();
+    freeHandles.clear();
+}
+
+#endif // INDEXED_MIN_HEAP_HPP
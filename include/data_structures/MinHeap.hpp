@@ -5,20 +5,24 @@
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
+#include <utility>
 
-template<typename T>
+// Array-backed d-ary min-heap. Arity 2 is the classic binary heap; 4 or 8
+// keep all children of a node in one cache line for small T.
+template<typename T, unsigned Arity = 2>
 class MinHeap {
 private:
     std::vector<T> heapArray;
     int heapSize;
     
-    int parent(int i) const { return (i - 1) / 2; }
-    int leftChild(int i) const { return 2 * i + 1; }
-    int rightChild(int i) const { return 2 * i + 2; }
+    int parent(int i) const { return (i - 1) / static_cast<int>(Arity); }
+    int firstChild(int i) const { return static_cast<int>(Arity) * i + 1; }
     
+    // Iterative hole-based sifts: the moving item is held aside and written
+    // once at its final slot, every other item moves one level per step
     void heapifyDown(int index);
     void heapifyUp(int index);
-
+    
 public:
     MinHeap();
     
@@ -29,31 +33,37 @@ public:
     int size() const { return heapSize; }
     void buildHeap(const std::vector<T>& elements);
     void clear() { heapArray.clear(); heapSize = 0; }
+    void reserve(size_t capacity) { heapArray.reserve(capacity); }
+    
+    // The k smallest items in order, without touching the heap - O(k log k)
+    std::vector<T> peekSmallest(int k) const;
     
     void display() const;
     const std::vector<T>& getHeapArray() const { return heapArray; }
 };
 
-template<typename T>
-MinHeap<T>::MinHeap() : heapSize(0) {
+template<typename T, unsigned Arity>
+MinHeap<T, Arity>::MinHeap() : heapSize(0) {
     heapArray.reserve(100);
 }
 
-template<typename T>
-void MinHeap<T>::insert(const T& item) {
+template<typename T, unsigned Arity>
+void MinHeap<T, Arity>::insert(const T& item) {
     heapArray.push_back(item);
     heapSize++;
     heapifyUp(heapSize - 1);
 }
 
-template<typename T>
-T MinHeap<T>::extractMin() {
+template<typename T, unsigned Arity>
+T MinHeap<T, Arity>::extractMin() {
     if (isEmpty()) {
         throw std::runtime_error("Heap is empty!");
     }
     
-    T minItem = heapArray[0];
-    heapArray[0] = heapArray[heapSize - 1];
+    T minItem = std::move(heapArray[0]);
+    if (heapSize > 1) {
+        heapArray[0] = std::move(heapArray[heapSize - 1]);
+    }
     heapArray.pop_back();
     heapSize--;
     
@@ -64,58 +74,93 @@ T MinHeap<T>::extractMin() {
     return minItem;
 }
 
-template<typename T>
-T MinHeap<T>::getMin() const {
+template<typename T, unsigned Arity>
+std::vector<T> MinHeap<T, Arity>::peekSmallest(int k) const {
+    std::vector<T> smallest;
+    if (k <= 0 || isEmpty()) return smallest;
+    smallest.reserve(std::min(k, heapSize));
+    
+    // Walk the heap array best-first: a small frontier heap of indices whose
+    // parents were already emitted always holds the next smallest item
+    auto later = [this](int a, int b) { return heapArray[b] < heapArray[a]; };
+    std::vector<int> frontier(1, 0);
+    while (!frontier.empty() && static_cast<int>(smallest.size()) < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), later);
+        int index = frontier.back();
+        frontier.pop_back();
+        smallest.push_back(heapArray[index]);
+        
+        int first = firstChild(index);
+        int last = std::min(first + static_cast<int>(Arity), heapSize);
+        for (int child = first; child < last; child++) {
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), later);
+        }
+    }
+    return smallest;
+}
+
+template<typename T, unsigned Arity>
+T MinHeap<T, Arity>::getMin() const {
     if (isEmpty()) {
         throw std::runtime_error("Heap is empty!");
     }
     return heapArray[0];
 }
 
-template<typename T>
-void MinHeap<T>::heapifyDown(int index) {
-    int smallest = index;
-    int left = leftChild(index);
-    int right = rightChild(index);
-    
-    if (left < heapSize && heapArray[left] < heapArray[smallest]) {
-        smallest = left;
-    }
+template<typename T, unsigned Arity>
+void MinHeap<T, Arity>::heapifyDown(int index) {
+    T moving = std::move(heapArray[index]);
     
-    if (right < heapSize && heapArray[right] < heapArray[smallest]) {
-        smallest = right;
+    while (true) {
+        int first = firstChild(index);
+        if (first >= heapSize) break;
+        
+        // Smallest of up to Arity contiguous children
+        int last = std::min(first + static_cast<int>(Arity), heapSize);
+        int smallest = first;
+        for (int child = first + 1; child < last; child++) {
+            if (heapArray[child] < heapArray[smallest]) {
+                smallest = child;
+            }
+        }
+        
+        if (!(heapArray[smallest] < moving)) break;
+        heapArray[index] = std::move(heapArray[smallest]);
+        index = smallest;
     }
     
-    if (smallest != index) {
-        std::swap(heapArray[index], heapArray[smallest]);
-        heapifyDown(smallest);
-    }
+    heapArray[index] = std::move(moving);
 }
 
-template<typename T>
-void MinHeap<T>::heapifyUp(int index) {
-    if (index == 0) return;
-    
-    int parentIdx = parent(index);
+template<typename T, unsigned Arity>
+void MinHeap<T, Arity>::heapifyUp(int index) {
+    T moving = std::move(heapArray[index]);
     
-    if (heapArray[index] < heapArray[parentIdx]) {
-        std::swap(heapArray[index], heapArray[parentIdx]);
-        heapifyUp(parentIdx);
+    while (index > 0) {
+        int parentIdx = parent(index);
+        if (!(moving < heapArray[parentIdx])) break;
+        heapArray[index] = std::move(heapArray[parentIdx]);
+        index = parentIdx;
     }
+    
+    heapArray[index] = std::move(moving);
 }
 
-template<typename T>
-void MinHeap<T>::buildHeap(const std::vector<T>& elements) {
+template<typename T, unsigned Arity>
+void MinHeap<T, Arity>::buildHeap(const std::vector<T>& elements) {
     heapArray = elements;
     heapSize = elements.size();
+    if (heapSize < 2) return;
     
-    for (int i = heapSize / 2 - 1; i >= 0; i--) {
+    // Floyd's bottom-up construction from the last internal node: O(n)
+    for (int i = (heapSize - 2) / static_cast<int>(Arity); i >= 0; i--) {
         heapifyDown(i);
     }
 }
 
-template<typename T>
-void MinHeap<T>::display() const {
+template<typename T, unsigned Arity>
+void MinHeap<T, Arity>::display() const {
     std::cout << "Heap contents (" << heapSize << " elements): ";
     for (int i = 0; i < heapSize; i++) {
         std::cout << heapArray[i] << " ";
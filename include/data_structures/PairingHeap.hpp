@@ -0,0 +1,320 @@
+#ifndef PAIRING_HEAP_HPP
+#define PAIRING_HEAP_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Pairing heap with pooled nodes and stable handles.
+// Nodes live in one vector and link to each other by index, so there is no
+// per-node allocation and a whole heap can be absorbed by another with a
+// single linear copy of its pool plus an O(1) link of the two roots.
+//
+// insert, meld: O(1). extractMin, erase: O(log n) amortized.
+// decrease-key: O(1) cut-and-link (amortized o(log n)).
+template<typename T>
+class PairingHeap {
+public:
+    typedef uint32_t Handle;
+    static const Handle INVALID_HANDLE = 0xFFFFFFFFu;
+    
+private:
+    struct Node {
+        T item;
+        Handle child;       // leftmost child
+        Handle next;        // right sibling
+        Handle prev;        // left sibling, or parent for a leftmost child
+        bool inHeap;
+        
+        Node(const T& i) : item(i), child(INVALID_HANDLE), next(INVALID_HANDLE),
+                           prev(INVALID_HANDLE), inHeap(true) {}
+    };
+    
+    std::vector<Node> pool;
+    std::vector<Handle> freeHandles;
+    std::vector<Handle> pairing;        // scratch for the two-pass merge
+    Handle root;
+    int count;
+    
+    // Links two roots; the larger becomes the leftmost child of the smaller
+    Handle link(Handle a, Handle b);
+    void cut(Handle node);              // detaches a non-root subtree
+    Handle mergePairs(Handle first);    // two-pass pairing of a sibling list
+    void checkHandle(Handle handle) const;
+    
+public:
+    PairingHeap() : root(INVALID_HANDLE), count(0) {}
+    
+    Handle insert(const T& item);                       // O(1)
+    T extractMin();                                     // O(log n) amortized
+    const T& getMin() const;                            // O(1)
+    Handle getMinHandle() const { return root; }
+    
+    // Either direction; a smaller key is a cut-and-link, a larger one re-links
+    // the node's children first. The handle stays valid.
+    void update(Handle handle, const T& item);
+    T erase(Handle handle);                             // O(log n) amortized
+    
+    // Takes every node of other (which is left empty). Handle h of other is
+    // h + the returned offset here. O(size of other's pool) copy, O(1) link.
+    Handle meld(PairingHeap&& other);
+    
+    // Rewrites items in place. fn must not change how any two items compare
+    // (e.g. a uniform shift), since no node is moved.
+    template<typename Fn> void rewriteItems(Fn fn);
+    template<typename Fn> void forEachItem(Fn fn) const;     // unordered
+    
+    bool contains(Handle handle) const {
+        return handle < pool.size() && pool[handle].inHeap;
+    }
+    const T& get(Handle handle) const { checkHandle(handle); return pool[handle].item; }
+    
+    // The k smallest items in order, without touching the heap. Scans the
+    // children of every emitted node but keeps at most 2k candidates, so it
+    // is O(k log k + those children): no more than O(n) comparisons even on
+    // a fresh heap whose root has every other node as a child.
+    std::vector<T> peekSmallest(size_t k) const;
+    
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    void reserve(size_t capacity) { pool.reserve(capacity); }
+    void clear();
+};
+
+template<typename T>
+const typename PairingHeap<T>::Handle PairingHeap<T>::INVALID_HANDLE;
+
+template<typename T>
+void PairingHeap<T>::checkHandle(Handle handle) const {
+    if (!contains(handle)) {
+        throw std::out_of_range("Invalid heap handle!");
+    }
+}
+
+template<typename T>
+typename PairingHeap<T>::Handle PairingHeap<T>::link(Handle a, Handle b) {
+    if (a == INVALID_HANDLE) return b;
+    if (b == INVALID_HANDLE) return a;
+    if (pool[b].item < pool[a].item) std::swap(a, b);
+    
+    // b becomes a's leftmost child
+    Node& parent = pool[a];
+    Node& child = pool[b];
+    child.next = parent.child;
+    if (parent.child != INVALID_HANDLE) pool[parent.child].prev = b;
+    child.prev = a;
+    parent.child = b;
+    parent.next = INVALID_HANDLE;
+    parent.prev = INVALID_HANDLE;
+    return a;
+}
+
+template<typename T>
+void PairingHeap<T>::cut(Handle node) {
+    Node& n = pool[node];
+    if (pool[n.prev].child == node) {
+        pool[n.prev].child = n.next;        // leftmost child: prev is the parent
+    } else {
+        pool[n.prev].next = n.next;
+    }
+    if (n.next != INVALID_HANDLE) pool[n.next].prev = n.prev;
+    n.next = INVALID_HANDLE;
+    n.prev = INVALID_HANDLE;
+}
+
+template<typename T>
+typename PairingHeap<T>::Handle PairingHeap<T>::mergePairs(Handle first) {
+    if (first == INVALID_HANDLE) return INVALID_HANDLE;
+    
+    // Pass 1, left to right: link neighbours in pairs
+    pairing.clear();
+    for (Handle a = first; a != INVALID_HANDLE; ) {
+        Handle b = pool[a].next;
+        Handle rest = (b != INVALID_HANDLE) ? pool[b].next : INVALID_HANDLE;
+        pool[a].next = pool[a].prev = INVALID_HANDLE;
+        if (b != INVALID_HANDLE) pool[b].next = pool[b].prev = INVALID_HANDLE;
+        pairing.push_back(link(a, b));
+        a = rest;
+    }
+    
+    // Pass 2, right to left: fold the pairs into one tree
+    Handle merged = pairing.back();
+    for (size_t i = pairing.size() - 1; i-- > 0; ) {
+        merged = link(pairing[i], merged);
+    }
+    return merged;
+}
+
+template<typename T>
+typename PairingHeap<T>::Handle PairingHeap<T>::insert(const T& item) {
+    Handle handle;
+    if (!freeHandles.empty()) {
+        handle = freeHandles.back();
+        freeHandles.pop_back();
+        pool[handle] = Node(item);
+    } else {
+        handle = static_cast<Handle>(pool.size());
+        pool.push_back(Node(item));
+    }
+    root = link(root, handle);
+    count++;
+    return handle;
+}
+
+template<typename T>
+const T& PairingHeap<T>::getMin() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Heap is empty!");
+    }
+    return pool[root].item;
+}
+
+template<typename T>
+T PairingHeap<T>::extractMin() {
+    if (isEmpty()) {
+        throw std::runtime_error("Heap is empty!");
+    }
+    return erase(root);
+}
+
+template<typename T>
+T PairingHeap<T>::erase(Handle handle) {
+    checkHandle(handle);
+    Handle children = pool[handle].child;
+    if (handle == root) {
+        root = INVALID_HANDLE;
+    } else {
+        cut(handle);
+    }
+    if (children != INVALID_HANDLE) pool[children].prev = INVALID_HANDLE;
+    root = link(root, mergePairs(children));
+    
+    Node& node = pool[handle];
+    node.inHeap = false;
+    node.child = INVALID_HANDLE;
+    freeHandles.push_back(handle);
+    count--;
+    return node.item;
+}
+
+template<typename T>
+void PairingHeap<T>::update(Handle handle, const T& item) {
+    checkHandle(handle);
+    Node& node = pool[handle];
+    bool smaller = item < node.item;
+    node.item = item;
+    
+    if (smaller) {
+        // Heap order below is intact; only the edge to the parent may break
+        if (handle != root) {
+            cut(handle);
+            root = link(root, handle);
+        }
+        return;
+    }
+    
+    // Larger: the children may now beat it, so hoist them and re-link alone
+    Handle children = node.child;
+    node.child = INVALID_HANDLE;
+    if (children != INVALID_HANDLE) pool[children].prev = INVALID_HANDLE;
+    if (handle == root) {
+        root = INVALID_HANDLE;
+    } else {
+        cut(handle);
+    }
+    root = link(link(root, mergePairs(children)), handle);
+}
+
+template<typename T>
+typename PairingHeap<T>::Handle PairingHeap<T>::meld(PairingHeap&& other) {
+    Handle offset = static_cast<Handle>(pool.size());
+    if (&other == this) return 0;
+    
+    // Shift every index in the other pool by offset and append it. No exact
+    // reserve here: repeated melds rely on geometric growth to stay linear.
+    for (const Node& source : other.pool) {
+        Node node = source;
+        if (node.child != INVALID_HANDLE) node.child += offset;
+        if (node.next != INVALID_HANDLE) node.next += offset;
+        if (node.prev != INVALID_HANDLE) node.prev += offset;
+        pool.push_back(node);
+    }
+    for (Handle handle : other.freeHandles) {
+        freeHandles.push_back(handle + offset);
+    }
+    
+    if (other.root != INVALID_HANDLE) {
+        root = link(root, other.root + offset);
+    }
+    count += other.count;
+    other.clear();
+    return offset;
+}
+
+template<typename T>
+template<typename Fn>
+void PairingHeap<T>::rewriteItems(Fn fn) {
+    for (Node& node : pool) {
+        if (node.inHeap) fn(node.item);
+    }
+}
+
+template<typename T>
+template<typename Fn>
+void PairingHeap<T>::forEachItem(Fn fn) const {
+    for (const Node& node : pool) {
+        if (node.inHeap) fn(node.item);
+    }
+}
+
+template<typename T>
+std::vector<T> PairingHeap<T>::peekSmallest(size_t k) const {
+    std::vector<T> smallest;
+    if (k == 0 || isEmpty()) return smallest;
+    
+    // Every child is no smaller than its parent, so a best-first walk over
+    // the tree with a small frontier heap yields items in order. Only the
+    // smallest `wanted` candidates can still be emitted, so once the
+    // frontier doubles past that it is cut back in linear time.
+    auto earlier = [this](Handle a, Handle b) { return pool[a].item < pool[b].item; };
+    auto later = [this](Handle a, Handle b) { return pool[b].item < pool[a].item; };
+    std::vector<Handle> frontier(1, root);
+    while (!frontier.empty() && smallest.size() < k) {
+        std::pop_heap(frontier.begin(), frontier.end(), later);
+        Handle node = frontier.back();
+        frontier.pop_back();
+        smallest.push_back(pool[node].item);
+        
+        size_t wanted = k - smallest.size();
+        if (wanted == 0) break;
+        size_t heaped = frontier.size();
+        for (Handle child = pool[node].child; child != INVALID_HANDLE; child = pool[child].next) {
+            frontier.push_back(child);
+            if (frontier.size() > 2 * wanted) {
+                std::nth_element(frontier.begin(), frontier.begin() + wanted, frontier.end(), earlier);
+                frontier.resize(wanted);
+                heaped = 0;
+            }
+        }
+        if (heaped == 0) {
+            std::make_heap(frontier.begin(), frontier.end(), later);
+        } else {
+            for (size_t i = heaped; i < frontier.size(); i++) {
+                std::push_heap(frontier.begin(), frontier.begin() + i + 1, later);
+            }
+        }
+    }
+    return smallest;
+}
+
+template<typename T>
+void PairingHeap<T>::clear() {
+    pool.clear();
+    freeHandles.clear();
+    root = INVALID_HANDLE;
+    count = 0;
+}
+
+#endif // PAIRING_HEAP_HPP
@@ -0,0 +1,107 @@
+#ifndef PATIENT_COLUMNS_HPP
+#define PATIENT_COLUMNS_HPP
+
+#include "../core/Patient.hpp"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+
+// Growable array whose storage starts on a 64-byte boundary, so SIMD loads
+// of a column never straddle a cache line at the start
+template<typename T>
+class AlignedColumn {
+private:
+    static const size_t ALIGNMENT = 64;
+    T* items;
+    size_t count;
+    size_t capacity;
+    void* block;            // what operator new returned; items points inside it
+    
+public:
+    AlignedColumn() : items(nullptr), count(0), capacity(0), block(nullptr) {}
+    ~AlignedColumn() { ::operator delete(block); }
+    AlignedColumn(const AlignedColumn&) = delete;
+    AlignedColumn& operator=(const AlignedColumn&) = delete;
+    
+    void reserve(size_t wanted);
+    void push_back(T value) {
+        if (count == capacity) reserve(capacity ? capacity * 2 : 64);
+        items[count++] = value;
+    }
+    void clear() { count = 0; }
+    
+    T& operator[](size_t index) { return items[index]; }
+    const T& operator[](size_t index) const { return items[index]; }
+    const T* data() const { return items; }
+    size_t size() const { return count; }
+};
+
+// Which kernel scores a batch. SSE2 and AVX2 are compiled with target
+// attributes, so they exist on any x86 build and are picked at run time.
+enum class ScoringPath {
+    SCALAR,
+    SSE2,       // 4 patients per step
+    AVX2        // 8 patients per step
+};
+
+// Struct-of-arrays copy of the fields severity depends on: heart rate,
+// blood pressure, oxygen level, temperature and arrival time each live in
+// their own aligned column. Re-scoring the whole population then streams
+// five dense arrays instead of walking fat Patient objects, and the vector
+// kernels evaluate every rule as branch-free compares and masks.
+//
+// Scores are bit-identical to Patient::calculateSeverityAt on every path.
+class PatientColumns {
+private:
+    AlignedColumn<int32_t> heartRate;
+    AlignedColumn<int32_t> bloodPressure;
+    AlignedColumn<int32_t> oxygenLevel;
+    AlignedColumn<double> temperature;
+    AlignedColumn<int64_t> arrivalTime;
+    
+public:
+    void reserve(size_t patients);
+    size_t append(const Patient& patient);                  // returns the row
+    void append(const std::vector<Patient>& patients);
+    void setVitals(size_t row, const VitalSigns& vitals);
+    void setArrivalTime(size_t row, time_t arrival) { arrivalTime[row] = static_cast<int64_t>(arrival); }
+    void clear();
+    
+    size_t size() const { return heartRate.size(); }
+    VitalSigns vitalsAt(size_t row) const;
+    time_t arrivalTimeAt(size_t row) const { return static_cast<time_t>(arrivalTime[row]); }
+    
+    // Severity of rows [first, first + count) at time now, written to out.
+    // Uses the fastest path this CPU supports. O(count)
+    void scoreRange(size_t first, size_t count, time_t now, int32_t* out) const;
+    void scoreAll(time_t now, int32_t* out) const { scoreRange(0, size(), now, out); }
+    // Same on a chosen path; throws if this CPU or build cannot run it
+    void scoreRange(size_t first, size_t count, time_t now, int32_t* out, ScoringPath path) const;
+    
+    static bool isSupported(ScoringPath path);
+    static ScoringPath bestPath();                          // detected once
+    static const char* pathName(ScoringPath path);
+};
+
+// Template implementation
+
+template<typename T>
+const size_t AlignedColumn<T>::ALIGNMENT;
+
+template<typename T>
+void AlignedColumn<T>::reserve(size_t wanted) {
+    if (wanted <= capacity) return;
+    void* grown = ::operator new(wanted * sizeof(T) + ALIGNMENT);
+    uintptr_t address = reinterpret_cast<uintptr_t>(grown);
+    T* aligned = reinterpret_cast<T*>((address + ALIGNMENT - 1) & ~static_cast<uintptr_t>(ALIGNMENT - 1));
+    for (size_t i = 0; i < count; i++) {
+        aligned[i] = items[i];
+    }
+    ::operator delete(block);
+    block = grown;
+    items = aligned;
+    capacity = wanted;
+}
+
+#endif // PATIENT_COLUMNS_HPP
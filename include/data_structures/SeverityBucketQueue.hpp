@@ -0,0 +1,67 @@
+#ifndef SEVERITY_BUCKET_QUEUE_HPP
+#define SEVERITY_BUCKET_QUEUE_HPP
+
+#include <vector>
+#include <cstdint>
+
+// Integer priority queue specialised for the 0..100 severity range.
+// One FIFO bucket per severity, threaded as intrusive doubly linked lists
+// through per-slot arrays, plus a bitmap of non-empty buckets so the lowest
+// one is a count-trailing-zeros away. Every operation is O(1).
+//
+// Items are caller-owned slot indices (e.g. positions in a Patient store).
+// Within a bucket, slots are served in the order they entered it.
+class SeverityBucketQueue {
+public:
+    static const int MAX_SEVERITY = 100;
+    static const int BUCKET_COUNT = MAX_SEVERITY + 1;
+    static const uint32_t NONE = 0xFFFFFFFFu;
+    
+private:
+    static const int WORD_BITS = 64;
+    static const int WORD_COUNT = (BUCKET_COUNT + WORD_BITS - 1) / WORD_BITS;
+    
+    struct Bucket {
+        uint32_t head;
+        uint32_t tail;
+    };
+    
+    Bucket buckets[BUCKET_COUNT];
+    uint64_t occupied[WORD_COUNT];      // bit b set <=> bucket b non-empty
+    
+    // Per-slot links; slotSeverity is -1 for slots not in the queue
+    std::vector<uint32_t> next;
+    std::vector<uint32_t> prev;
+    std::vector<int8_t> slotSeverity;
+    int count;
+    
+    void link(uint32_t slot, int severity);     // append at the bucket tail
+    void unlink(uint32_t slot);
+    int firstBucketFrom(int severity) const;    // lowest non-empty >= severity, or -1
+    static void checkSeverity(int severity);
+    
+public:
+    SeverityBucketQueue();
+    
+    void insert(uint32_t slot, int severity);   // O(1)
+    uint32_t extractMin();                      // O(1)
+    uint32_t getMin() const;                    // O(1)
+    
+    // Moves a slot to the back of its new bucket; same severity keeps its place
+    void update(uint32_t slot, int severity);   // O(1)
+    void erase(uint32_t slot);                  // O(1)
+    
+    bool contains(uint32_t slot) const {
+        return slot < slotSeverity.size() && slotSeverity[slot] >= 0;
+    }
+    int severityOf(uint32_t slot) const;
+    
+    // Service-order walk without dequeuing: getMin(), then successor() until NONE
+    uint32_t successor(uint32_t slot) const;
+    
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    void clear();
+};
+
+#endif // SEVERITY_BUCKET_QUEUE_HPP
@@ -3,34 +3,81 @@
 
 #include <vector>
 #include <stdexcept>
+#include <utility>
 
+// Bounded undo stack on a circular buffer. Once full, a push overwrites the
+// oldest entry in place instead of shifting every stored state down, so
+// push and pop stay O(1) at any depth. The buffer grows to its capacity on
+// demand and is then reused; no slot is allocated until it is first needed.
 template<typename T>
 class StateStack {
 private:
-    std::vector<T> stack;
+    std::vector<T> buffer;
     size_t maxSize;
-
+    size_t bottom;          // buffer index of the oldest state
+    size_t count;
+    
+    size_t slotOf(size_t depth) const { return (bottom + depth) % maxSize; }
+    static void checkCapacity(size_t capacity);
+    template<typename U> void pushState(U&& state);
+    
 public:
-    StateStack(size_t max = 100) : maxSize(max) {}
+    StateStack(size_t max = 100) : maxSize(max), bottom(0), count(0) {
+        checkCapacity(max);
+    }
     
-    void push(const T& state);              // O(1) amortized
+    void push(const T& state);              // O(1)
+    void push(T&& state);                   // O(1)
     T pop();                                // O(1)
-    T peek() const;                         // O(1)
+    const T& peek() const;                  // O(1)
+    const T& peekOldest() const;            // O(1), the state a push onto a full stack evicts
+    const T& at(size_t depth) const;        // O(1), depth 0 is the oldest state
     void clear();                           // O(1)
-    bool isEmpty() const { return stack.empty(); }
-    size_t size() const { return stack.size(); }
-    bool isFull() const { return stack.size() >= maxSize; }
+    bool isEmpty() const { return count == 0; }
+    size_t size() const { return count; }
+    bool isFull() const { return count >= maxSize; }
+    
+    // Shrinking keeps the newest states. O(size)
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const { return maxSize; }
 };
 
 // Template implementation
 
 template<typename T>
-void StateStack<T>::push(const T& state) {
+void StateStack<T>::checkCapacity(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Stack capacity must be positive!");
+    }
+}
+
+template<typename T>
+template<typename U>
+void StateStack<T>::pushState(U&& state) {
     if (isFull()) {
-        // Remove oldest state (bottom of stack)
-        stack.erase(stack.begin());
+        // Overwrite the oldest state; the slot above the top is the bottom
+        buffer[bottom] = std::forward<U>(state);
+        bottom = slotOf(1);
+        return;
+    }
+    
+    size_t slot = slotOf(count);
+    if (slot == buffer.size()) {
+        buffer.push_back(std::forward<U>(state));
+    } else {
+        buffer[slot] = std::forward<U>(state);
     }
-    stack.push_back(state);
+    count++;
+}
+
+template<typename T>
+void StateStack<T>::push(const T& state) {
+    pushState(state);
+}
+
+template<typename T>
+void StateStack<T>::push(T&& state) {
+    pushState(std::move(state));
 }
 
 template<typename T>
@@ -38,22 +85,56 @@ T StateStack<T>::pop() {
     if (isEmpty()) {
         throw std::runtime_error("Stack is empty!");
     }
-    T state = stack.back();
-    stack.pop_back();
-    return state;
+    count--;
+    return std::move(buffer[slotOf(count)]);
 }
 
 template<typename T>
-T StateStack<T>::peek() const {
+const T& StateStack<T>::peek() const {
     if (isEmpty()) {
         throw std::runtime_error("Stack is empty!");
     }
-    return stack.back();
+    return buffer[slotOf(count - 1)];
+}
+
+template<typename T>
+const T& StateStack<T>::peekOldest() const {
+    if (isEmpty()) {
+        throw std::runtime_error("Stack is empty!");
+    }
+    return buffer[bottom];
+}
+
+template<typename T>
+const T& StateStack<T>::at(size_t depth) const {
+    if (depth >= count) {
+        throw std::out_of_range("Stack depth out of range!");
+    }
+    return buffer[slotOf(depth)];
 }
 
 template<typename T>
 void StateStack<T>::clear() {
-    stack.clear();
+    bottom = 0;
+    count = 0;
+}
+
+template<typename T>
+void StateStack<T>::setCapacity(size_t capacity) {
+    checkCapacity(capacity);
+    
+    // Unroll the ring oldest-first, dropping states that no longer fit
+    size_t kept = (count < capacity) ? count : capacity;
+    std::vector<T> states;
+    states.reserve(kept);
+    for (size_t depth = count - kept; depth < count; depth++) {
+        states.push_back(std::move(buffer[slotOf(depth)]));
+    }
+    
+    buffer.swap(states);
+    maxSize = capacity;
+    bottom = 0;
+    count = kept;
 }
 
-#endif // STATE_STACK_HPP
\ No newline at end of file
+#endif // STATE_STACK_HPP
@@ -1,34 +1,133 @@
 #ifndef TRIAGE_QUEUE_HPP
 #define TRIAGE_QUEUE_HPP
 
-#include "MinHeap.hpp"
+#include "IndexedMinHeap.hpp"
+#include "PairingHeap.hpp"
+#include "SeverityBucketQueue.hpp"
+#include "TriageRecord.hpp"
+#include "FlatHashMap.hpp"
 #include "../core/Patient.hpp"
 #include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <ctime>
 
+enum class TriageBackend {
+    INDEXED_HEAP,       // 4-ary heap of TriageRecords - O(log n), any integer severity
+    SEVERITY_BUCKETS,   // 101 FIFO buckets + bitmap - O(1), severity 0..100 only
+    PAIRING_HEAP        // Pooled pairing heap - O(1) insert and meld, for merging queues
+};
+
+// All backends serve lower severity first and, within a severity, in the
+// order patients reached it (a severity change sends a patient to the back
+// of the new level).
+//
+// Aging (heap backends only): a waiting patient's severity drops one point
+// every Patient::SECONDS_PER_SEVERITY_POINT, so stored scores go stale.
+// Instead of re-scoring, the heap is keyed on
+//     base * SECONDS_PER_SEVERITY_POINT + (arrival - epoch)
+// which never changes while a patient waits. Sorting by this key never
+// puts a patient ahead of one who is strictly more urgent at the current
+// time, so extraction order matches a full re-score at any moment.
 class TriageQueue {
 private:
-    MinHeap<Patient> patientHeap;
+    typedef IndexedMinHeap<TriageRecord> RecordHeap;
+    typedef PairingHeap<TriageRecord> RecordPairingHeap;
+    
+    TriageBackend backend;
+    
+    // The queue only orders store slots; each Patient is stored once, in a
+    // slot that stays put until the patient leaves the queue
+    RecordHeap recordHeap;
+    SeverityBucketQueue severityBuckets;
+    RecordPairingHeap pairingHeap;
+    std::vector<Patient> patientStore;
+    std::vector<uint32_t> slotHandle;               // store slot -> heap handle (heap backends)
+    std::vector<uint32_t> freeSlots;
+    FlatHashMap<PatientId, uint32_t> slotIndex;    // patientID -> store slot
+    
+    uint32_t nextArrival;
     int totalPatientsProcessed;
-
+    bool verbose;
+    bool agingEnabled;
+    time_t agingEpoch;          // arrival-time origin for aging keys
+    
+    int priorityOf(const Patient& patient) const;
+    Patient currentView(uint32_t slot) const;   // stored patient, score as of now
+    
+    bool usesHandles() const { return backend != TriageBackend::SEVERITY_BUCKETS; }
+    uint32_t storePatient(const Patient& patient);
+    Patient releasePatient(uint32_t slot);
+    
+    // Backend dispatch, all in terms of store slots
+    void enqueueSlot(uint32_t slot, int priority);
+    void rekeySlot(uint32_t slot, int priority);
+    void dropSlot(uint32_t slot);
+    uint32_t dequeueSlot();
+    uint32_t frontSlot() const;
+    std::vector<TriageRecord> collectRecords() const;  // every queued record, any order
+    void resetQueue();
+    
 public:
-    TriageQueue();
+    explicit TriageQueue(TriageBackend backend = TriageBackend::INDEXED_HEAP);
     
     // Core triage operations
-    void addPatient(const Patient& patient);                    // O(log n)
-    Patient getNextPatient();                                   // O(log n)
+    void addPatient(const Patient& patient);                    // O(log n), buckets O(1)
+    // Mass admission: same result as adding one by one, but one heapify
+    // and one console line for the whole batch
+    void addPatientsBatch(const std::vector<Patient>& patients);    // O(n + m)
+    Patient getNextPatient();                                   // O(log n), buckets O(1)
     Patient peekNextPatient() const;                            // O(1)
     
+    // Takes over every waiting patient of other, which is left empty. Patients
+    // already queued here are refreshed, as with addPatient. Equal priorities
+    // keep their own order, with other's patients after ours. With pairing
+    // heaps on both sides the heaps meld in O(1) after an O(m) pool copy;
+    // otherwise other's records are bulk-inserted. Aging settings must match.
+    void mergeFrom(TriageQueue&& other);                        // O(m) + meld
+    
     // Advanced operations
-    void updatePatientPriority(const std::string& patientID, const VitalSigns& newVitals);
-    std::vector<Patient> getCriticalPatients(int count);        // O(k log n)
+    void updatePatientPriority(const PatientId& patientID, const VitalSigns& newVitals);    // O(log n), buckets O(1)
+    bool removePatient(const PatientId& patientID);             // O(log n), buckets O(1)
+    // Removes a patient treated by ID rather than popped (journal replay),
+    // counted as processed just as getNextPatient would count it
+    bool removeTreatedPatient(const PatientId& patientID);      // O(log n), buckets O(1)
+    bool contains(const PatientId& patientID) const;            // O(1)
+    std::vector<Patient> getCriticalPatients(int count) const;  // O(k log k), read-only
+    // Visits waiting patients in the order they reached their current
+    // severity; re-adding them in that order rebuilds an equivalent queue
+    template <typename Fn>
+    void forEachWaitingPatient(Fn fn) const;                    // O(n log n)
     
     // Status
-    bool isEmpty() const { return patientHeap.isEmpty(); }
-    int getPendingCount() const { return patientHeap.size(); }
+    bool isEmpty() const { return getPendingCount() == 0; }
+    int getPendingCount() const;
+    TriageBackend getBackend() const { return backend; }
     int getTotalProcessed() const { return totalPatientsProcessed; }
+    void setTotalProcessed(int processed) { totalPatientsProcessed = processed; }     // snapshot restore
+    
+    // Waiting-time escalation without re-scoring; only on an empty heap-backed
+    // queue. Returned patients carry their score as of the moment they leave.
+    void setAgingEnabled(bool enabled);
+    bool isAgingEnabled() const { return agingEnabled; }
+    
+    // Per-operation console messages (on by default)
+    void setVerbose(bool enabled) { verbose = enabled; }
     
     // Display
-    void displayQueue() const;
+    void displayQueue(int topCount = 5) const;     // status plus the next topCount patients
 };
 
-#endif // TRIAGE_QUEUE_HPP
\ No newline at end of file
+template <typename Fn>
+void TriageQueue::forEachWaitingPatient(Fn fn) const {
+    std::vector<TriageRecord> records = collectRecords();
+    std::sort(records.begin(), records.end(), [](const TriageRecord& a, const TriageRecord& b) {
+        return a.arrivalSeq < b.arrivalSeq;
+    });
+    for (const TriageRecord& record : records) {
+        fn(patientStore[record.patientIndex]);
+    }
+}
+
+#endif // TRIAGE_QUEUE_HPP
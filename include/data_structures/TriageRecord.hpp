@@ -0,0 +1,23 @@
+#ifndef TRIAGE_RECORD_HPP
+#define TRIAGE_RECORD_HPP
+
+#include <cstdint>
+
+// What the triage queue actually orders: 12 bytes of plain data instead of
+// a full Patient. Lower priority key first; equal keys in arrival order.
+struct TriageRecord {
+    int32_t priority;           // Severity score 0 (critical) .. 100, or an aging key
+    uint32_t arrivalSeq;        // Queue-wide arrival counter, for FIFO ties
+    uint32_t patientIndex;      // Slot of the Patient in the queue's store
+    
+    TriageRecord() : priority(0), arrivalSeq(0), patientIndex(0) {}
+    TriageRecord(int32_t key, uint32_t seq, uint32_t index)
+        : priority(key), arrivalSeq(seq), patientIndex(index) {}
+    
+    bool operator<(const TriageRecord& other) const {
+        if (priority != other.priority) return priority < other.priority;
+        return arrivalSeq < other.arrivalSeq;
+    }
+};
+
+#endif // TRIAGE_RECORD_HPP
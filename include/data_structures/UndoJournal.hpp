@@ -0,0 +1,179 @@
+#ifndef UNDO_JOURNAL_HPP
+#define UNDO_JOURNAL_HPP
+
+#include "StateStack.hpp"
+#include "FlatHashMap.hpp"
+#include "../core/Patient.hpp"
+#include "../core/MedicalStaff.hpp"
+#include "../utils/BinaryRecord.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum class OperationType : uint8_t {
+    PATIENT_REGISTERED,
+    PATIENT_TREATED,
+    PATIENT_TRANSFERRED,
+    PATIENT_DISCHARGED,
+    STAFF_ASSIGNED,
+    EQUIPMENT_ALLOCATED,
+    PATIENTS_BATCH_REGISTERED,
+    VITALS_UPDATED
+};
+
+// One undo record, 16 bytes. Only the fields an operation changed are kept;
+// IDs and locations are interned symbols, and descriptions come from a
+// static table. Which payload member is live depends on the operation:
+//   PATIENT_REGISTERED         - none, or spill (the replaced registration)
+//   PATIENT_TREATED/DISCHARGED - statusBefore/statusAfter (TriageStatus)
+//   VITALS_UPDATED             - vitals (after - before), or spill
+//   PATIENT_TRANSFERRED        - move
+//   STAFF_ASSIGNED             - staff, statusBefore (AvailabilityStatus)
+//   PATIENTS_BATCH_REGISTERED  - spill (how many registrations the batch
+//                                replaced and where they start, then the
+//                                newly admitted IDs)
+struct UndoEntry {
+    static const uint8_t SPILLED = 1;       // payload.spill points at side storage
+    
+    struct VitalsDelta {
+        int16_t heartRate;
+        int16_t bloodPressure;
+        int16_t oxygenLevel;
+        int16_t temperatureCenti;           // hundredths of a degree
+    };
+    struct Move {
+        uint32_t from;
+        uint32_t to;
+    };
+    struct StaffChange {
+        uint32_t staff;
+        uint32_t previousPatient;           // NO_SYMBOL when the staff was free
+    };
+    struct Spill {
+        uint32_t first;                     // position in the journal's side storage
+        uint32_t count;
+    };
+    
+    OperationType operation;
+    uint8_t flags;
+    uint8_t statusBefore;
+    uint8_t statusAfter;
+    uint32_t subject;                       // patient symbol
+    union {
+        VitalsDelta vitals;
+        Move move;
+        StaffChange staff;
+        Spill spill;
+    } payload;
+};
+
+// A registration that a later one overwrote, kept whole for undo
+struct ReplacedRegistration {
+    Patient patient;
+    bool wasQueued;                         // it was waiting in triage
+    
+    ReplacedRegistration() : wasQueued(false) {}
+    ReplacedRegistration(const Patient& patient, bool wasQueued) 
+        : patient(patient), wasQueued(wasQueued) {}
+};
+
+// Bounded undo log of UndoEntry records on a StateStack ring. The rare
+// payloads that do not fit an entry (batch ID lists, vitals whose delta
+// is not exact in 16 bits, replaced registrations) go to side storage
+// that is trimmed as entries are popped or evicted. Symbols are counted
+// per reference from live entries: one per distinct patient, staff or
+// location name, kept as an inline Symbol so interning never allocates a
+// string, and released for reuse when the last entry naming it goes.
+//
+// Rollback is pop-driven: read top() and its payload through the
+// accessors, apply it, then pop(), which releases any side storage.
+class UndoJournal {
+public:
+    static const uint32_t NO_SYMBOL = 0xFFFFFFFFu;
+    typedef FixedId<struct UndoSymbolTag> Symbol;   // any ID kind; retag with the explicit ctor
+    
+private:
+    // Side storage addressed by absolute position: appended and popped at
+    // the back, released from the front as the oldest entries are evicted
+    template<typename T>
+    struct SideStore {
+        std::vector<T> items;
+        uint32_t base;          // absolute position of items[0]
+        size_t released;        // dead items at the front, compacted lazily
+        
+        SideStore() : base(0), released(0) {}
+        uint32_t end() const { return base + static_cast<uint32_t>(items.size()); }
+        const T& at(uint32_t position) const { return items[position - base]; }
+        void truncate(uint32_t position);       // drop position and everything after
+        void releaseBefore(uint32_t position);  // drop everything before position
+        void clear() { items.clear(); base = 0; released = 0; }
+    };
+    
+    StateStack<UndoEntry> entries;
+    std::vector<Symbol> symbols;
+    std::vector<uint32_t> symbolRefs;           // live entries naming each symbol
+    std::vector<uint32_t> freeSymbols;          // released IDs, reused before the table grows
+    FlatHashMap<Symbol, uint32_t> symbolIndex;
+    SideStore<uint32_t> spilledSymbols;
+    SideStore<VitalSigns> spilledVitals;
+    SideStore<ReplacedRegistration> spilledPatients;
+    
+    uint32_t intern(const Symbol& name);        // adds a reference
+    bool isSymbol(uint32_t id) const { return id < symbols.size() && symbolRefs[id] > 0; }
+    bool isIntact(const UndoEntry& entry) const;    // every symbol and spill it names exists
+    void releaseSymbol(uint32_t id);
+    void releaseSymbols(const UndoEntry& entry);    // drops the entry's references
+    void push(const UndoEntry& entry);          // releases what an evicted entry held
+    void releaseSpill(const UndoEntry& entry, bool evicted);
+    static UndoEntry makeEntry(OperationType operation, uint32_t subject);
+    
+public:
+    explicit UndoJournal(size_t capacity = 100);
+    
+    // Recording: O(1) apart from interning the IDs involved
+    // replaced is the registration this one overwrote, or nullptr
+    void recordRegistration(const PatientId& patientID, const Patient* replaced, bool replacedWasQueued);
+    // replaced holds the registrations the batch overwrote, each once
+    void recordBatchRegistration(const std::vector<PatientId>& newPatientIDs,
+                                 const std::vector<ReplacedRegistration>& replaced);
+    void recordStatusChange(OperationType operation, const PatientId& patientID,
+                            TriageStatus before, TriageStatus after);
+    void recordVitalsChange(const PatientId& patientID, const VitalSigns& before, const VitalSigns& after);
+    void recordTransfer(const PatientId& patientID, const LocationId& from, const LocationId& to);
+    void recordStaffAssignment(const PatientId& patientID, const MedicalStaff& staffBefore);
+    
+    // Rollback
+    const UndoEntry& top() const { return entries.peek(); }
+    void pop();                                 // O(1) amortized
+    const Symbol& symbol(uint32_t id) const { return symbols[id]; }
+    // Vitals before a VITALS_UPDATED entry, given the vitals after it
+    VitalSigns previousVitals(const UndoEntry& entry, const VitalSigns& current) const;
+    std::vector<PatientId> batchPatientIDs(const UndoEntry& entry) const;   // new IDs only
+    // Registrations a PATIENT_REGISTERED or batch entry overwrote
+    size_t replacedCount(const UndoEntry& entry) const;
+    const ReplacedRegistration& replaced(const UndoEntry& entry, size_t index = 0) const;
+    
+    // Status
+    bool isEmpty() const { return entries.isEmpty(); }
+    size_t size() const { return entries.size(); }
+    size_t getCapacity() const { return entries.getCapacity(); }
+    void clear();
+    // Approximate live bytes: entries, side storage and the symbol table
+    size_t memoryUsage() const;
+    size_t symbolCount() const { return symbols.size() - freeSymbols.size(); }
+    
+    // Snapshot encoding of the whole history. Patient records go through the
+    // caller's codec so they match the rest of the file. decode replaces the
+    // contents and throws std::runtime_error on a malformed history.
+    typedef void (*PatientWriter)(RecordWriter& record, const Patient& patient);
+    typedef Patient (*PatientReader)(RecordReader& record);
+    void encode(RecordWriter& record, PatientWriter writePatient) const;     // O(size)
+    void decode(RecordReader& record, PatientReader readPatient);           // O(size)
+    
+    // Display
+    static std::string getOperationString(OperationType operation);
+    static std::string getDescription(OperationType operation);
+    void display(const UndoEntry& entry) const;
+};
+
+#endif // UNDO_JOURNAL_HPP
@@ -0,0 +1,111 @@
+#ifndef BINARY_RECORD_HPP
+#define BINARY_RECORD_HPP
+
+#include "../core/FixedId.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// Little-endian field encoding shared by the on-disk formats. Strings are
+// a u32 length followed by their bytes; doubles are stored as their bits.
+class RecordWriter {
+private:
+    std::vector<char> bytes;
+    
+public:
+    void putU8(uint8_t value) { bytes.push_back(static_cast<char>(value)); }
+    void putU32(uint32_t value) {
+        char field[4];
+        for (int i = 0; i < 4; i++) field[i] = static_cast<char>(value >> (8 * i));
+        bytes.insert(bytes.end(), field, field + 4);
+    }
+    void putU64(uint64_t value) {
+        char field[8];
+        for (int i = 0; i < 8; i++) field[i] = static_cast<char>(value >> (8 * i));
+        bytes.insert(bytes.end(), field, field + 8);
+    }
+    void putI32(int32_t value) { putU32(static_cast<uint32_t>(value)); }
+    void putI64(int64_t value) { putU64(static_cast<uint64_t>(value)); }
+    void putDouble(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putU64(bits);
+    }
+    void putString(const char* value, size_t length) {
+        putU32(static_cast<uint32_t>(length));
+        bytes.insert(bytes.end(), value, value + length);
+    }
+    void putString(const std::string& value) { putString(value.data(), value.size()); }
+    template <typename Tag>
+    void putString(const FixedId<Tag>& value) { putString(value.data(), value.size()); }    // same encoding, no temporary
+    
+    // Overwrites a field written earlier, e.g. a count only known at the end
+    void patchU32(size_t offset, uint32_t value) {
+        for (int i = 0; i < 4; i++) bytes[offset + i] = static_cast<char>(value >> (8 * i));
+    }
+    
+    const char* data() const { return bytes.data(); }
+    size_t size() const { return bytes.size(); }
+    void clear() { bytes.clear(); }
+    // Hands over the encoded bytes without a copy; the writer is left empty
+    std::vector<char> release() {
+        std::vector<char> released;
+        released.swap(bytes);
+        return released;
+    }
+};
+
+// Bounds-checked reader over one record; throws on a short record
+class RecordReader {
+private:
+    const unsigned char* cursor;
+    const unsigned char* end;
+    
+    void need(size_t count) const {
+        if (static_cast<size_t>(end - cursor) < count) {
+            throw std::runtime_error("Truncated record!");
+        }
+    }
+    
+public:
+    RecordReader(const char* data, size_t size)
+        : cursor(reinterpret_cast<const unsigned char*>(data)),
+          end(reinterpret_cast<const unsigned char*>(data) + size) {}
+    
+    uint8_t getU8() { need(1); return *cursor++; }
+    uint32_t getU32() {
+        need(4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) value |= static_cast<uint32_t>(cursor[i]) << (8 * i);
+        cursor += 4;
+        return value;
+    }
+    uint64_t getU64() {
+        need(8);
+        uint64_t value = 0;
+        for (int i = 0; i < 8; i++) value |= static_cast<uint64_t>(cursor[i]) << (8 * i);
+        cursor += 8;
+        return value;
+    }
+    int32_t getI32() { return static_cast<int32_t>(getU32()); }
+    int64_t getI64() { return static_cast<int64_t>(getU64()); }
+    double getDouble() {
+        uint64_t bits = getU64();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string getString() {
+        uint32_t length = getU32();
+        need(length);
+        std::string value(reinterpret_cast<const char*>(cursor), length);
+        cursor += length;
+        return value;
+    }
+    
+    size_t remaining() const { return static_cast<size_t>(end - cursor); }
+};
+
+#endif // BINARY_RECORD_HPP
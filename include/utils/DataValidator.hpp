@@ -4,13 +4,18 @@
 #include "../core/Patient.hpp"
 #include "../core/HospitalRoom.hpp"
 #include <string>
+#include <vector>
 
 class DataValidator {
 public:
     // Patient validation
     static bool validatePatientData(const Patient& patient);
     static bool validateVitalSigns(const VitalSigns& vitals);
-    static bool validatePatientID(const std::string& id);
+    static bool validatePatientID(const std::string& id);      // also rejects IDs too long for PatientId
+    static bool validatePatientID(const PatientId& id);
+    // Silent bulk check; valid[i] says whether patients[i] passed. Returns the count.
+    static size_t validatePatientBatch(const std::vector<Patient>& patients, 
+                                       std::vector<bool>& valid);
     
     // Room validation
     static bool validateRoomData(const HospitalRoom& room);
@@ -0,0 +1,49 @@
+#ifndef FILE_IO_HPP
+#define FILE_IO_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Thin layer over the platform's unbuffered file API, shared by the journal
+// and the snapshot writer. Calls report failure instead of throwing; callers
+// turn that into their own error message.
+class FileIO {
+public:
+    static int openReadWrite(const std::string& path);     // creates the file; -1 on failure
+    static bool truncate(int fd, uint64_t length);
+    static bool seekToEnd(int fd);
+    static bool writeAll(int fd, const char* data, size_t size);
+    static bool sync(int fd);                               // fsync, _commit on Windows
+    static void close(int fd);
+    
+    // Writes path + ".tmp", syncs it and renames it over path, so path holds
+    // either the old contents or the new ones, never a torn mix
+    static bool replaceFile(const std::string& path, const char* data, size_t size);
+    
+    // CRC-32 (IEEE 802.3); pass the previous result to checksum in pieces
+    static uint32_t crc32(const char* data, size_t size, uint32_t crc = 0);
+};
+
+// Read-only view of a whole file: mmap on POSIX, so pages load on first
+// touch instead of being copied up front; a plain read on Windows
+class MappedFile {
+private:
+    const char* bytes;
+    size_t length;
+    void* mapping;                  // non-null while mmapped
+    std::vector<char> fallback;     // contents when not mapped
+    
+public:
+    explicit MappedFile(const std::string& path);   // throws if path cannot be read
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+#endif // FILE_IO_HPP
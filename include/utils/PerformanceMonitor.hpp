@@ -10,12 +10,17 @@ class PerformanceMonitor {
 private:
     static std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> timers;
     static std::unordered_map<std::string, long long> durations;
+    static std::unordered_map<std::string, long long> counters;
 
 public:
     // Timer operations
     static void startTimer(const std::string& operationName);
     static long long stopTimer(const std::string& operationName);  // Returns duration in microseconds
     
+    // Event counters (cache hits, fallbacks, ...)
+    static void recordCount(const std::string& counterName, long long value);
+    static long long getCount(const std::string& counterName);
+    
     // Reporting
     static void displayReport();
     static void displayComplexityAnalysis();
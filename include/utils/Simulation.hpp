@@ -2,6 +2,7 @@
 #define SIMULATION_HPP
 
 #include "../core/Patient.hpp"
+#include "../algorithms/Graph.hpp"
 #include <vector>
 #include <string>
 
@@ -35,6 +36,10 @@ public:
     static Patient generateRandomPatient(int id);
     static VitalSigns generateRandomVitals(bool critical = false);
     
+    // rows x cols corridor grid named "N_<row>_<col>", 10m apart; corridor
+    // weights are 10-14m so they never undercut the straight-line distance
+    static void generateCampusLayout(Graph& layout, int rows, int cols, unsigned seed = 42);
+    
     // Simulation execution
     static SimulationResults runEmergencySimulation(const SimulationConfig& config);
     
@@ -0,0 +1,45 @@
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+// Long-lived threads for fork-join batches.
+//
+// run(participants, job) calls job(0) on the calling thread and job(1) ..
+// job(participants - 1) on pool threads, and returns once every call has
+// finished. Threads are started the first time a batch needs them and park
+// on a condition variable in between, so a batch costs one wake-up per
+// worker instead of a thread create and join.
+class WorkerPool {
+public:
+    WorkerPool();
+    ~WorkerPool();          // stops and joins every thread
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    
+    // Not reentrant: one batch at a time, from one calling thread
+    void run(unsigned participants, const std::function<void(unsigned)>& job);
+    
+    unsigned getThreadCount() const;        // pool threads started so far
+    
+private:
+    mutable std::mutex lock;
+    std::condition_variable wakeWorkers;
+    std::condition_variable batchDone;
+    std::vector<std::thread> threads;
+    const std::function<void(unsigned)>* job;
+    unsigned activeWorkers;         // pool threads taking part in the current batch
+    unsigned unfinished;            // of those, still running
+    uint64_t generation;            // bumped per pooled batch so a thread joins each once
+    bool stopping;
+    
+    void workerLoop(unsigned participant, uint64_t seen);
+    void waitForWorkers();
+};
+
+#endif // WORKER_POOL_HPP
@@ -0,0 +1,100 @@
+#ifndef WRITE_AHEAD_LOG_HPP
+#define WRITE_AHEAD_LOG_HPP
+
+#include "BinaryRecord.hpp"
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+// Append-only operation journal with group commit.
+//
+// File: a 24-byte header ("HEROSWAL", u32 version, u32 reserved, u64
+// position of the file's first record), then records of
+// [u32 body length][u32 CRC-32 of body][body = u8 type + payload].
+// Positions count records since the journal began, so they stay valid
+// when discardBefore() starts the file over at a later record.
+//
+// append() only copies the record into a memory buffer. A committer thread
+// swaps that buffer out every commit interval (or sooner once it is large),
+// writes it with one write() and makes it durable with one fsync (_commit
+// on Windows), so the fsync cost is shared by every record in the group.
+// A record is durable once sync() returns or the next group commit ends.
+//
+// Recovery reads records in order and stops at the first short or
+// corrupt one (a torn tail from a crash); reopening truncates it away.
+class WriteAheadLog {
+public:
+    static const uint32_t FORMAT_VERSION = 2;
+    static const size_t HEADER_SIZE = 24;
+    
+    // A point between two records: what a snapshot covers
+    struct Mark {
+        uint64_t position;      // of the next record
+        uint64_t offset;        // in the file, where that record starts
+    };
+    
+    // Replays the intact records of path in order, applying those at
+    // position from onwards. Sets endPosition to the position after the
+    // last intact record (from, when the file is missing or not a journal)
+    // and returns the length of the valid prefix in bytes. Throws if the
+    // file starts after from: the records in between were discarded.
+    static uint64_t replay(const std::string& path, uint64_t from,
+                           const std::function<void(uint8_t type, RecordReader& payload)>& apply,
+                           uint64_t& endPosition);
+    
+    // Opens path for appending after its first validLength bytes (anything
+    // beyond is discarded). A new or invalid file starts with a fresh header.
+    // nextPosition is the position the next record gets, as replay reported.
+    WriteAheadLog(const std::string& path, uint64_t validLength,
+                  unsigned commitIntervalMicros = 2000, uint64_t nextPosition = 0);
+    ~WriteAheadLog();       // commits everything still buffered
+    
+    void append(uint8_t type, const RecordWriter& payload);     // O(record), never waits on disk
+    void sync();            // returns once all appends, and any discardBefore(), are durable
+    
+    // Syncs and marks the end of the journal. Call from the appending thread.
+    Mark mark();
+    // Drops the records before mark once a snapshot holds them: the
+    // committer copies the later records into a new file that atomically
+    // replaces the journal, so a cold start never reads the old ones.
+    // Returns at once; safe to call from any thread.
+    void discardBefore(const Mark& mark);
+    
+    uint64_t getRecordCount() const;
+    uint64_t getCommitCount() const;
+    
+private:
+    static const size_t EAGER_COMMIT_BYTES = 1 << 20;
+    
+    std::string path;
+    int fd;
+    unsigned commitIntervalMicros;
+    uint64_t startPosition;             // position of the first record appended this session
+    uint64_t fileLength;                // bytes durably in the file
+    
+    mutable std::mutex lock;
+    std::condition_variable wakeCommitter;
+    std::condition_variable committed;
+    std::vector<char> pending;          // appended, not yet handed to the committer
+    uint64_t appendedRecords;
+    uint64_t durableRecords;
+    uint64_t commitCount;
+    bool syncRequested;
+    bool discardRequested;
+    Mark discardMark;
+    bool stopping;
+    std::string failure;                // set if a write or fsync failed
+    std::thread committer;
+    
+    void commitLoop();
+    void writeDurably(const std::vector<char>& bytes);
+    void startOver(const Mark& mark);   // committer only
+    static void putHeader(RecordWriter& header, uint64_t firstPosition);
+    void checkFailure() const;
+};
+
+#endif // WRITE_AHEAD_LOG_HPP
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <stdexcept>
 
 void displayMainMenu() {
     std::cout << "\n";
@@ -207,11 +208,15 @@ int main() {
                 case 1:
                     runFullSimulation(system);
                     break;
-                    
+                
                 case 2:
-                    registerManualPatient(system);
+                    try {
+                        registerManualPatient(system);
+                    } catch (const std::length_error& e) {
+                        std::cout << "Error: " << e.what() << "\n";
+                    }
                     break;
-                    
+                
                 case 3:
                     try {
                         Patient p = system.processNextCriticalPatient();
@@ -220,7 +225,7 @@ int main() {
                         std::cout << "Error: " << e.what() << "\n";
                     }
                     break;
-                    
+                
                 case 4: {
                     std::cout << "Enter Staff ID: ";
                     std::string staffID;
@@ -228,14 +233,18 @@ int main() {
                     std::cout << "Enter Patient ID: ";
                     std::string patientID;
                     std::getline(std::cin, patientID);
-                    system.assignStaffToPatient(staffID, patientID);
+                    try {
+                        system.assignStaffToPatient(staffID, patientID);
+                    } catch (const std::length_error& e) {
+                        std::cout << "Error: " << e.what() << "\n";
+                    }
                     break;
                 }
-                    
+                
                 case 5:
                     system.optimizeEquipmentDistribution();
                     break;
-                    
+                
                 case 6: {
                     std::cout << "Enter start location: ";
                     std::string start;
@@ -243,39 +252,43 @@ int main() {
                     std::cout << "Enter end location: ";
                     std::string end;
                     std::getline(std::cin, end);
-                    RouteInfo route = system.findFastestRoute(start, end);
+                    try {
+                        RouteInfo route = system.findFastestRoute(start, end);
+                    } catch (const std::length_error& e) {
+                        std::cout << "Error: " << e.what() << "\n";
+                    }
                     break;
                 }
-                    
+                
                 case 7:
                     compareSortingAlgorithms();
                     break;
-                    
+                
                 case 8:
                     system.undoLastOperation();
                     break;
-                    
+                
                 case 9:
                     system.displaySystemStatus();
                     break;
-                    
+                
                 case 10:
                     system.displayTriageQueue();
                     break;
-                    
+                
                 case 11:
                     system.generatePerformanceReport();
                     break;
-                    
+                
                 case 12:
                     std::cout << "Hospital layout graph visualization\n";
                     break;
-                    
+                
                 case 0:
                     std::cout << "\n* Thank you for using H.E.R.O.S!\n";
                     std::cout << "============================================\n";
                     return 0;
-                    
+                
                 default:
                     std::cout << "Invalid choice! Please try again.\n";
             }
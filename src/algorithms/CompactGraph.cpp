@@ -0,0 +1,143 @@
+#include "../../include/algorithms/CompactGraph.hpp"
+#include "../../include/algorithms/Graph.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+// Slack for floating-point round-off when comparing weights to distances
+static const double EUCLIDEAN_TOLERANCE = 1e-9;
+
+const uint32_t CompactGraph::INVALID_NODE;
+const uint32_t CompactGraph::MAX_BUCKET_WEIGHT;
+
+CompactGraph::CompactGraph() : subEuclideanEdges(0), irregularEdges(0), maxIntegerWeight(0) {
+    offsets.push_back(0);
+    reverseOffsets.push_back(0);
+}
+
+CompactGraph::CompactGraph(const Graph& graph) 
+    : subEuclideanEdges(0), irregularEdges(0), maxIntegerWeight(0) {
+    // Intern rooms in insertion order, then any corridor endpoint that was
+    // never registered with addNode (it still needs a slot to be routable)
+    nodeNames.reserve(graph.nodeOrder.size());
+    for (const LocationId& node : graph.nodeOrder) {
+        intern(node);
+    }
+    for (const auto& pair : graph.adjacencyList) {
+        intern(pair.first);
+        for (const Edge& edge : pair.second) {
+            intern(edge.to);
+        }
+    }
+
+    uint32_t nodeCount = getNodeCount();
+    positions.resize(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        positions[i] = graph.getNodePosition(nodeNames[i]);
+    }
+
+    // Counting pass: out-degree of every node, then prefix sums
+    offsets.assign(nodeCount + 1, 0);
+    for (const auto& pair : graph.adjacencyList) {
+        offsets[nodeIndex[pair.first] + 1] += static_cast<uint32_t>(pair.second.size());
+    }
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    // Fill pass
+    targets.resize(offsets[nodeCount]);
+    weights.resize(offsets[nodeCount]);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (const auto& pair : graph.adjacencyList) {
+        uint32_t from = nodeIndex[pair.first];
+        for (const Edge& edge : pair.second) {
+            uint32_t slot = cursor[from]++;
+            targets[slot] = nodeIndex[edge.to];
+            weights[slot] = edge.effectiveWeight();
+            classifyEdge(from, targets[slot], weights[slot], 1);
+        }
+    }
+    
+    // Reverse adjacency by the same counting-sort construction
+    reverseOffsets.assign(nodeCount + 1, 0);
+    for (uint32_t e = 0; e < targets.size(); e++) {
+        reverseOffsets[targets[e] + 1]++;
+    }
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        reverseOffsets[i + 1] += reverseOffsets[i];
+    }
+    
+    reverseSources.resize(targets.size());
+    reverseEdges.resize(targets.size());
+    std::vector<uint32_t> reverseCursor(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (uint32_t from = 0; from < nodeCount; from++) {
+        for (uint32_t e = offsets[from]; e < offsets[from + 1]; e++) {
+            uint32_t slot = reverseCursor[targets[e]]++;
+            reverseSources[slot] = from;
+            reverseEdges[slot] = e;
+        }
+    }
+}
+
+void CompactGraph::classifyEdge(uint32_t from, uint32_t to, double weight, int count) {
+    if (weight == std::numeric_limits<double>::infinity()) return;
+    
+    double lineDistance = straightLineDistance(from, to);
+    if (weight < lineDistance - EUCLIDEAN_TOLERANCE * std::max(1.0, lineDistance)) {
+        subEuclideanEdges += count;
+    }
+    
+    if (weight >= 0.0 && weight <= MAX_BUCKET_WEIGHT && weight == std::floor(weight)) {
+        if (count > 0) {
+            maxIntegerWeight = std::max(maxIntegerWeight, static_cast<uint32_t>(weight));
+        }
+    } else {
+        irregularEdges += count;
+    }
+}
+
+void CompactGraph::patchEdgeWeight(uint32_t from, uint32_t edge, double weight) {
+    // Reverse slots point at this forward slot, so one write updates both
+    classifyEdge(from, targets[edge], weights[edge], -1);
+    weights[edge] = weight;
+    classifyEdge(from, targets[edge], weight, 1);
+}
+
+uint32_t CompactGraph::intern(const LocationId& name) {
+    auto it = nodeIndex.find(name);
+    if (it != nodeIndex.end()) {
+        return it->second;
+    }
+
+    uint32_t index = static_cast<uint32_t>(nodeNames.size());
+    nodeIndex[name] = index;
+    nodeNames.push_back(name);
+    return index;
+}
+
+uint32_t CompactGraph::indexOf(const LocationId& name) const {
+    auto it = nodeIndex.find(name);
+    return (it != nodeIndex.end()) ? it->second : INVALID_NODE;
+}
+
+double CompactGraph::straightLineDistance(uint32_t from, uint32_t to) const {
+    double dx = positions[to].x - positions[from].x;
+    double dy = positions[to].y - positions[from].y;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+size_t CompactGraph::getMemoryUsage() const {
+    size_t bytes = offsets.capacity() * sizeof(uint32_t)
+                 + targets.capacity() * sizeof(uint32_t)
+                 + weights.capacity() * sizeof(double)
+                 + reverseOffsets.capacity() * sizeof(uint32_t)
+                 + reverseSources.capacity() * sizeof(uint32_t)
+                 + reverseEdges.capacity() * sizeof(uint32_t)
+                 + positions.capacity() * sizeof(Coordinates);
+    bytes += nodeNames.capacity() * sizeof(LocationId);
+    // Interning table: one bucket pointer plus one node per entry
+    bytes += nodeIndex.bucket_count() * sizeof(void*)
+           + nodeIndex.size() * (sizeof(LocationId) + sizeof(uint32_t) + sizeof(void*));
+    return bytes;
+}
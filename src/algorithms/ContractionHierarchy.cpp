@@ -0,0 +1,411 @@
+#include "../../include/algorithms/ContractionHierarchy.hpp"
+#include <queue>
+#include <limits>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// Witness searches give up after this many settled nodes, or beyond this
+// many arcs from the source, and assume no witness exists - that only costs
+// an unnecessary shortcut, never correctness. Importance estimates use a
+// shorter hop limit than the real contraction.
+static const size_t SIMULATION_SETTLE_LIMIT = 100;
+static const size_t CONTRACTION_SETTLE_LIMIT = 1000;
+static const uint32_t SIMULATION_HOP_LIMIT = 5;
+static const uint32_t CONTRACTION_HOP_LIMIT = 16;
+
+typedef std::pair<double, uint32_t> QueueEntry;
+typedef std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > DistanceQueue;
+
+ContractionHierarchy::ContractionHierarchy() {}
+
+void ContractionHierarchy::addOrImproveArc(std::vector<Arc>& arcs, uint32_t node,
+                                           double weight, uint32_t middle) {
+    for (Arc& arc : arcs) {
+        if (arc.node == node) {
+            if (weight < arc.weight) {
+                arc.weight = weight;
+                arc.middle = middle;
+            }
+            return;
+        }
+    }
+    arcs.push_back(Arc(node, weight, middle));
+}
+
+void ContractionHierarchy::removeArc(std::vector<Arc>& arcs, uint32_t node) {
+    for (size_t i = 0; i < arcs.size(); i++) {
+        if (arcs[i].node == node) {
+            arcs[i] = arcs.back();
+            arcs.pop_back();
+            return;
+        }
+    }
+}
+
+void ContractionHierarchy::witnessSearch(const std::vector<std::vector<Arc> >& out,
+                                         const std::vector<uint8_t>& contracted,
+                                         uint32_t source, uint32_t skipped, double limit,
+                                         size_t targetCount, size_t settleLimit, uint32_t hopLimit) {
+    // Heap storage is reused across the many small searches of a build
+    std::vector<QueueEntry>& heap = witnessHeap;
+    std::greater<QueueEntry> later;
+    heap.clear();
+    witnessDistance[source] = 0.0;
+    witnessHops[source] = 0;
+    witnessTouched.push_back(source);
+    heap.push_back(QueueEntry(0.0, source));
+    
+    size_t settled = 0;
+    while (!heap.empty() && settled < settleLimit) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        QueueEntry current = heap.back();
+        heap.pop_back();
+        
+        if (current.first > witnessDistance[current.second]) continue;   // stale entry
+        if (current.first > limit) break;
+        settled++;
+        
+        // Done once every neighbour of the skipped node has a final distance
+        if (witnessTarget[current.second] && --targetCount == 0) break;
+        if (witnessHops[current.second] >= hopLimit) continue;
+        
+        for (const Arc& arc : out[current.second]) {
+            if (contracted[arc.node] || arc.node == skipped) continue;
+            
+            double newDist = current.first + arc.weight;
+            if (newDist < witnessDistance[arc.node]) {
+                if (witnessDistance[arc.node] == std::numeric_limits<double>::infinity()) {
+                    witnessTouched.push_back(arc.node);
+                }
+                witnessDistance[arc.node] = newDist;
+                witnessHops[arc.node] = witnessHops[current.second] + 1;
+                heap.push_back(QueueEntry(newDist, arc.node));
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+}
+
+uint32_t ContractionHierarchy::processNode(std::vector<std::vector<Arc> >& out,
+                                           std::vector<std::vector<Arc> >& in,
+                                           const std::vector<uint8_t>& contracted,
+                                           uint32_t node, bool simulate) {
+    uint32_t shortcuts = 0;
+    
+    for (const Arc& incoming : in[node]) {
+        uint32_t from = incoming.node;
+        if (contracted[from]) continue;
+        
+        double limit = -1.0;
+        size_t targetCount = 0;
+        for (const Arc& outgoing : out[node]) {
+            if (!contracted[outgoing.node] && outgoing.node != from) {
+                limit = std::max(limit, incoming.weight + outgoing.weight);
+                witnessTarget[outgoing.node] = 1;
+                targetCount++;
+            }
+        }
+        if (limit < 0.0) continue;
+        
+        witnessSearch(out, contracted, from, node, limit, targetCount,
+                      simulate ? SIMULATION_SETTLE_LIMIT : CONTRACTION_SETTLE_LIMIT,
+                      simulate ? SIMULATION_HOP_LIMIT : CONTRACTION_HOP_LIMIT);
+        
+        // A shortcut is needed wherever no path avoiding node is as short
+        for (const Arc& outgoing : out[node]) {
+            uint32_t to = outgoing.node;
+            if (contracted[to] || to == from) continue;
+            
+            double via = incoming.weight + outgoing.weight;
+            if (witnessDistance[to] > via) {
+                shortcuts++;
+                if (!simulate) {
+                    addOrImproveArc(out[from], to, via, node);
+                    addOrImproveArc(in[to], from, via, node);
+                }
+            }
+        }
+        
+        for (uint32_t touched : witnessTouched) {
+            witnessDistance[touched] = std::numeric_limits<double>::infinity();
+        }
+        witnessTouched.clear();
+        for (const Arc& outgoing : out[node]) {
+            witnessTarget[outgoing.node] = 0;
+        }
+    }
+    
+    return shortcuts;
+}
+
+void ContractionHierarchy::build(const CompactGraph& graph) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    uint32_t n = graph.getNodeCount();
+    std::vector<std::vector<Arc> > out(n);
+    std::vector<std::vector<Arc> > in(n);
+    
+    // Working overlay: one arc per (from, to) pair, self loops dropped
+    for (uint32_t u = 0; u < n; u++) {
+        for (uint32_t e = graph.edgesBegin(u); e < graph.edgesEnd(u); e++) {
+            uint32_t v = graph.edgeTarget(e);
+            double w = graph.edgeWeight(e);
+            if (v == u || w == std::numeric_limits<double>::infinity()) continue;
+            addOrImproveArc(out[u], v, w, CompactGraph::INVALID_NODE);
+            addOrImproveArc(in[v], u, w, CompactGraph::INVALID_NODE);
+        }
+    }
+    
+    stats = HierarchyStats();
+    stats.nodeCount = n;
+    for (uint32_t u = 0; u < n; u++) {
+        stats.originalEdges += static_cast<uint32_t>(out[u].size());
+    }
+    
+    witnessDistance.assign(n, std::numeric_limits<double>::infinity());
+    witnessHops.assign(n, 0);
+    witnessTarget.assign(n, 0);
+    witnessTouched.clear();
+    
+    std::vector<uint8_t> contracted(n, 0);
+    std::vector<int> contractedNeighbours(n, 0);
+    std::vector<int> level(n, 0);
+    std::vector<std::vector<Arc> > upward(n);
+    std::vector<std::vector<Arc> > downward(n);
+    rank.assign(n, 0);
+    
+    // Importance = 2 x edge difference + contracted neighbours + level. The
+    // last two spread contraction evenly, which keeps query search spaces small.
+    auto importanceOf = [&](uint32_t v) {
+        int degree = static_cast<int>(in[v].size() + out[v].size());
+        int edgeDifference = static_cast<int>(processNode(out, in, contracted, v, true)) - degree;
+        return 2 * edgeDifference + contractedNeighbours[v] + level[v];
+    };
+    typedef std::pair<int, uint32_t> Importance;
+    std::priority_queue<Importance, std::vector<Importance>, std::greater<Importance> > order;
+    for (uint32_t v = 0; v < n; v++) {
+        order.push(Importance(importanceOf(v), v));
+    }
+    
+    std::vector<uint32_t> neighbours;
+    uint32_t nextRank = 0;
+    while (!order.empty()) {
+        uint32_t v = order.top().second;
+        order.pop();
+        if (contracted[v]) continue;
+        
+        // Lazy update: re-evaluate, and requeue if no longer the least important
+        int importance = importanceOf(v);
+        if (!order.empty() && importance > order.top().first) {
+            order.push(Importance(importance, v));
+            continue;
+        }
+        
+        processNode(out, in, contracted, v, false);
+        contracted[v] = 1;
+        rank[v] = nextRank++;
+        
+        // Every remaining neighbour outranks v: its arcs are final upward arcs.
+        // Detach v so the live graph the witness searches walk keeps shrinking.
+        neighbours.clear();
+        for (const Arc& arc : out[v]) {
+            upward[v].push_back(arc);
+            removeArc(in[arc.node], v);
+            neighbours.push_back(arc.node);
+        }
+        for (const Arc& arc : in[v]) {
+            downward[v].push_back(arc);
+            removeArc(out[arc.node], v);
+            neighbours.push_back(arc.node);
+        }
+        std::vector<Arc>().swap(out[v]);
+        std::vector<Arc>().swap(in[v]);
+        
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        for (uint32_t neighbour : neighbours) {
+            contractedNeighbours[neighbour]++;
+            level[neighbour] = std::max(level[neighbour], level[v] + 1);
+        }
+    }
+    
+    // Flatten into the two upward CSR graphs
+    upOffsets.assign(n + 1, 0);
+    downOffsets.assign(n + 1, 0);
+    upArcs.clear();
+    downArcs.clear();
+    for (uint32_t u = 0; u < n; u++) {
+        upArcs.insert(upArcs.end(), upward[u].begin(), upward[u].end());
+        downArcs.insert(downArcs.end(), downward[u].begin(), downward[u].end());
+        upOffsets[u + 1] = static_cast<uint32_t>(upArcs.size());
+        downOffsets[u + 1] = static_cast<uint32_t>(downArcs.size());
+    }
+    upArcs.shrink_to_fit();
+    downArcs.shrink_to_fit();
+    
+    std::vector<double>().swap(witnessDistance);
+    std::vector<uint32_t>().swap(witnessTouched);
+    std::vector<uint32_t>().swap(witnessHops);
+    std::vector<uint8_t>().swap(witnessTarget);
+    std::vector<std::pair<double, uint32_t> >().swap(witnessHeap);
+    
+    for (const Arc& arc : upArcs) stats.shortcutCount += (arc.middle != CompactGraph::INVALID_NODE);
+    for (const Arc& arc : downArcs) stats.shortcutCount += (arc.middle != CompactGraph::INVALID_NODE);
+    stats.memoryBytes = rank.capacity() * sizeof(uint32_t)
+                      + (upOffsets.capacity() + downOffsets.capacity()) * sizeof(uint32_t)
+                      + (upArcs.capacity() + downArcs.capacity()) * sizeof(Arc);
+    stats.preprocessingMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - startTime
+    ).count();
+}
+
+uint32_t ContractionHierarchy::query(uint32_t source, uint32_t target,
+                                     SearchSpace& forward, SearchSpace& backward) const {
+    uint32_t n = static_cast<uint32_t>(rank.size());
+    forward.prepare(n);
+    backward.prepare(n);
+    
+    DistanceQueue forwardQueue;
+    DistanceQueue backwardQueue;
+    forward.touch(source);
+    forward.distance[source] = 0.0;
+    forwardQueue.push(QueueEntry(0.0, source));
+    backward.touch(target);
+    backward.distance[target] = 0.0;
+    backwardQueue.push(QueueEntry(0.0, target));
+    
+    double best = std::numeric_limits<double>::infinity();
+    uint32_t meeting = CompactGraph::INVALID_NODE;
+    
+    while (true) {
+        bool forwardActive = !forwardQueue.empty() && forwardQueue.top().first < best;
+        bool backwardActive = !backwardQueue.empty() && backwardQueue.top().first < best;
+        if (!forwardActive && !backwardActive) break;
+        
+        bool expandForward = forwardActive &&
+            (!backwardActive || forwardQueue.top().first <= backwardQueue.top().first);
+        DistanceQueue& queue = expandForward ? forwardQueue : backwardQueue;
+        SearchSpace& self = expandForward ? forward : backward;
+        const SearchSpace& other = expandForward ? backward : forward;
+        
+        QueueEntry current = queue.top();
+        queue.pop();
+        uint32_t u = current.second;
+        
+        if (self.settled[u]) continue;
+        self.settled[u] = 1;
+        self.settledCount++;
+        
+        if (current.first + other.distance[u] < best) {
+            best = current.first + other.distance[u];
+            meeting = u;
+        }
+        
+        // Stall on demand: a higher-ranked node that already reaches u more
+        // cheaply means u's label is not a shortest distance, and neither is
+        // anything climbed from it
+        const std::vector<uint32_t>& reverseOffsets = expandForward ? downOffsets : upOffsets;
+        const std::vector<Arc>& reverseArcs = expandForward ? downArcs : upArcs;
+        bool stalled = false;
+        for (uint32_t i = reverseOffsets[u]; i < reverseOffsets[u + 1]; i++) {
+            if (self.distance[reverseArcs[i].node] + reverseArcs[i].weight < current.first) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) continue;
+        
+        // Only climb: arcs to higher-ranked nodes
+        const std::vector<uint32_t>& offsets = expandForward ? upOffsets : downOffsets;
+        const std::vector<Arc>& arcs = expandForward ? upArcs : downArcs;
+        for (uint32_t i = offsets[u]; i < offsets[u + 1]; i++) {
+            uint32_t next = arcs[i].node;
+            double newDist = current.first + arcs[i].weight;
+            if (newDist < self.distance[next]) {
+                self.touch(next);
+                self.distance[next] = newDist;
+                self.previous[next] = u;
+                queue.push(QueueEntry(newDist, next));
+            }
+        }
+    }
+    
+    return meeting;
+}
+
+const ContractionHierarchy::Arc* ContractionHierarchy::findArc(uint32_t from, uint32_t to) const {
+    // from->to is stored at its lower-ranked endpoint
+    if (rank[from] < rank[to]) {
+        for (uint32_t i = upOffsets[from]; i < upOffsets[from + 1]; i++) {
+            if (upArcs[i].node == to) return &upArcs[i];
+        }
+    } else {
+        for (uint32_t i = downOffsets[to]; i < downOffsets[to + 1]; i++) {
+            if (downArcs[i].node == from) return &downArcs[i];
+        }
+    }
+    return nullptr;
+}
+
+void ContractionHierarchy::unpackArc(uint32_t from, uint32_t to, std::vector<uint32_t>& path) const {
+    // Iterative expansion: shortcut from->to becomes from->middle->to
+    std::vector<std::pair<uint32_t, uint32_t> > pending;
+    pending.push_back(std::make_pair(from, to));
+    
+    while (!pending.empty()) {
+        std::pair<uint32_t, uint32_t> arc = pending.back();
+        pending.pop_back();
+        
+        const Arc* stored = findArc(arc.first, arc.second);
+        if (stored == nullptr || stored->middle == CompactGraph::INVALID_NODE) {
+            path.push_back(arc.second);
+        } else {
+            pending.push_back(std::make_pair(stored->middle, arc.second));
+            pending.push_back(std::make_pair(arc.first, stored->middle));
+        }
+    }
+}
+
+std::vector<uint32_t> ContractionHierarchy::unpackPath(uint32_t source, uint32_t target,
+                                                       uint32_t meeting,
+                                                       const SearchSpace& forward,
+                                                       const SearchSpace& backward) const {
+    std::vector<uint32_t> path;
+    if (meeting == CompactGraph::INVALID_NODE) {
+        return path;
+    }
+    
+    // Hierarchy-level path: source ... meeting ... target
+    std::vector<uint32_t> upward;
+    for (uint32_t node = meeting; node != source; node = forward.previous[node]) {
+        upward.push_back(node);
+    }
+    upward.push_back(source);
+    std::reverse(upward.begin(), upward.end());
+    for (uint32_t node = meeting; node != target; ) {
+        node = backward.previous[node];
+        upward.push_back(node);
+    }
+    
+    path.push_back(source);
+    for (size_t i = 0; i + 1 < upward.size(); i++) {
+        unpackArc(upward[i], upward[i + 1], path);
+    }
+    return path;
+}
+
+void ContractionHierarchy::displayStats() const {
+    std::cout << "\n╔════════════════════════════════════════════════╗\n";
+    std::cout << "║        CONTRACTION HIERARCHY                   ║\n";
+    std::cout << "╠════════════════════════════════════════════════╣\n";
+    std::cout << "║ Nodes: " << std::setw(39) << stats.nodeCount << " ║\n";
+    std::cout << "║ Original Corridors: " << std::setw(26) << stats.originalEdges << " ║\n";
+    std::cout << "║ Shortcuts Added: " << std::setw(29) << stats.shortcutCount << " ║\n";
+    std::cout << "║ Preprocessing Time: " << std::setw(23) << std::fixed << std::setprecision(2)
+              << stats.preprocessingMicros / 1000.0 << "ms ║\n";
+    std::cout << "║ Memory: " << std::setw(35) << std::fixed << std::setprecision(1)
+              << stats.memoryBytes / 1024.0 << "KB ║\n";
+    std::cout << "╚════════════════════════════════════════════════╝\n";
+}
@@ -1,86 +1,655 @@
 #include "../../include/algorithms/DijkstraRouter.hpp"
 #include <queue>
-#include <unordered_map>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>  // ADD THIS LINE
+#include <thread>
+#include <atomic>
 
-DijkstraRouter::DijkstraRouter(Graph* graph) : hospitalMap(graph) {}
+// Enough for every room-to-room pair a shift keeps asking for
+static const size_t DEFAULT_ROUTE_CACHE_CAPACITY = 256;
 
-RouteInfo DijkstraRouter::findShortestPath(const std::string& start, const std::string& end) {
-    RouteInfo result;
+DijkstraRouter::DijkstraRouter(Graph* graph) 
+    : hospitalMap(graph), routingMode(RoutingMode::DIJKSTRA), 
+      bucketQueueEnabled(true), batchThreadCount(0), heuristicWarningShown(false),
+      hierarchyWarningShown(false), lastSettledCount(0), hierarchyVersion(0), lastRepairCount(0),
+      routeCacheCapacity(DEFAULT_ROUTE_CACHE_CAPACITY), cacheVersion(graph->getVersion()), cacheHits(0), cacheMisses(0) {}
+
+void DijkstraRouter::runDijkstra(const CompactGraph& view, uint32_t source,
+                                 const std::vector<uint32_t>& targets, SearchSpace& space) const {
+    space.prepare(view.getNodeCount());
     
-    if (!hospitalMap->hasNode(start) || !hospitalMap->hasNode(end)) {
-        std::cout << "Error: Start or end node not found in graph!\n";
-        return result;
+    size_t remaining = 0;
+    for (uint32_t target : targets) {
+        if (!space.isTarget[target]) {
+            space.isTarget[target] = 1;
+            remaining++;
+        }
     }
     
-    // Priority queue: min-heap based on distance
-    std::priority_queue<DijkstraNode, std::vector<DijkstraNode>, std::greater<DijkstraNode>> pq;
-    
-    std::unordered_map<std::string, double> distances;
-    std::unordered_map<std::string, std::string> previous;
-    std::unordered_map<std::string, bool> visited;
+    // Whole-metre corridors (the usual case) need no comparison heap at all
+    if (bucketQueueEnabled && view.hasSmallIntegerWeights()) {
+        runBucketSearch(view, source, remaining, space);
+    } else {
+        runHeapSearch(view, source, remaining, space);
+    }
     
-    // Initialize distances
-    for (const std::string& node : hospitalMap->getAllNodes()) {
-        distances[node] = std::numeric_limits<double>::infinity();
-        visited[node] = false;
+    for (uint32_t target : targets) {
+        space.isTarget[target] = 0;
     }
+}
+
+void DijkstraRouter::runHeapSearch(const CompactGraph& view, uint32_t source,
+                                   size_t remaining, SearchSpace& space) const {
+    // Min-heap on distance, kept in the search space so its storage is reused
+    std::vector<std::pair<double, uint32_t> >& heap = space.heap;
+    std::greater<std::pair<double, uint32_t> > later;
+    heap.clear();
     
-    distances[start] = 0.0;
-    pq.push(DijkstraNode(start, 0.0));
+    space.touch(source);
+    space.distance[source] = 0.0;
+    heap.push_back(std::make_pair(0.0, source));
     
     // Dijkstra's algorithm: O((V+E) log V)
-    while (!pq.empty()) {
-        DijkstraNode current = pq.top();
-        pq.pop();
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        double distance = heap.back().first;
+        uint32_t current = heap.back().second;
+        heap.pop_back();
         
-        if (visited[current.id]) continue;
-        visited[current.id] = true;
+        if (space.settled[current]) continue;
+        space.settled[current] = 1;
+        space.settledCount++;
         
-        if (current.id == end) break;
+        // Early exit once every requested destination is settled
+        if (space.isTarget[current] && --remaining == 0) break;
         
         // Explore neighbors
-        for (const Edge& edge : hospitalMap->getEdges(current.id)) {
-            double newDist = distances[current.id] + edge.weight;
+        for (uint32_t e = view.edgesBegin(current); e < view.edgesEnd(current); e++) {
+            uint32_t next = view.edgeTarget(e);
+            double newDist = distance + view.edgeWeight(e);
             
-            if (newDist < distances[edge.to]) {
-                distances[edge.to] = newDist;
-                previous[edge.to] = current.id;
-                pq.push(DijkstraNode(edge.to, newDist));
+            if (newDist < space.distance[next]) {
+                space.touch(next);
+                space.distance[next] = newDist;
+                space.previous[next] = current;
+                heap.push_back(std::make_pair(newDist, next));
+                std::push_heap(heap.begin(), heap.end(), later);
             }
         }
     }
+}
+
+void DijkstraRouter::runBucketSearch(const CompactGraph& view, uint32_t source,
+                                     size_t remaining, SearchSpace& space) const {
+    // Dial's algorithm: tentative distances are whole numbers and never more
+    // than maxWeight ahead of the current one, so maxWeight + 1 circular
+    // buckets hold the whole frontier. O(E + maxDistance), no comparisons.
+    size_t bucketCount = static_cast<size_t>(view.getMaxIntegerWeight()) + 1;
+    if (space.buckets.size() < bucketCount) {
+        space.buckets.resize(bucketCount);
+    }
+    
+    space.touch(source);
+    space.distance[source] = 0.0;
+    space.buckets[0].push_back(source);
+    size_t pending = 1;
     
-    // Reconstruct path
-    if (distances[end] != std::numeric_limits<double>::infinity()) {
-        std::vector<std::string> path;
-        std::string current = end;
+    uint64_t current = 0;
+    bool finished = false;
+    while (pending > 0 && !finished) {
+        std::vector<uint32_t>& bucket = space.buckets[current % bucketCount];
+        double currentDist = static_cast<double>(current);
         
-        while (current != start) {
-            path.push_back(current);
-            current = previous[current];
+        // Zero-weight corridors append to this same bucket; index, don't iterate
+        for (size_t i = 0; i < bucket.size(); i++) {
+            uint32_t node = bucket[i];
+            pending--;
+            
+            // Stale entry: node was settled or re-bucketed at a lower distance
+            if (space.settled[node] || space.distance[node] != currentDist) continue;
+            space.settled[node] = 1;
+            space.settledCount++;
+            
+            if (space.isTarget[node] && --remaining == 0) {
+                finished = true;
+                break;
+            }
+            
+            for (uint32_t e = view.edgesBegin(node); e < view.edgesEnd(node); e++) {
+                uint32_t next = view.edgeTarget(e);
+                double newDist = currentDist + view.edgeWeight(e);
+                
+                if (newDist < space.distance[next]) {
+                    space.touch(next);
+                    space.distance[next] = newDist;
+                    space.previous[next] = node;
+                    space.buckets[static_cast<uint64_t>(newDist) % bucketCount].push_back(next);
+                    pending++;
+                }
+            }
         }
-        path.push_back(start);
+        bucket.clear();
+        current++;
+    }
+    
+    // Early exit leaves stale entries behind; the next search expects empty buckets
+    if (finished) {
+        for (size_t b = 0; b < bucketCount; b++) {
+            space.buckets[b].clear();
+        }
+    }
+}
+
+void DijkstraRouter::runAStar(const CompactGraph& view, uint32_t source, uint32_t target,
+                              SearchSpace& space) const {
+    space.prepare(view.getNodeCount());
+    
+    // Queue key is f = g + h, with h the straight-line distance to the target.
+    // Weights never undercut h, so h is consistent and settled nodes are final.
+    std::priority_queue<DijkstraNode, std::vector<DijkstraNode>, std::greater<DijkstraNode>> pq;
+    
+    space.touch(source);
+    space.distance[source] = 0.0;
+    pq.push(DijkstraNode(source, view.straightLineDistance(source, target)));
+    
+    while (!pq.empty()) {
+        uint32_t current = pq.top().id;
+        pq.pop();
+        
+        if (space.settled[current]) continue;
+        space.settled[current] = 1;
+        space.settledCount++;
+        
+        if (current == target) break;
+        
+        for (uint32_t e = view.edgesBegin(current); e < view.edgesEnd(current); e++) {
+            uint32_t next = view.edgeTarget(e);
+            double newDist = space.distance[current] + view.edgeWeight(e);
+            
+            if (newDist < space.distance[next]) {
+                space.touch(next);
+                space.distance[next] = newDist;
+                space.previous[next] = current;
+                pq.push(DijkstraNode(next, newDist + view.straightLineDistance(next, target)));
+            }
+        }
+    }
+}
+
+uint32_t DijkstraRouter::runBidirectional(const CompactGraph& view, uint32_t source, uint32_t target,
+                                          SearchSpace& forward, SearchSpace& backward) const {
+    forward.prepare(view.getNodeCount());
+    backward.prepare(view.getNodeCount());
+    
+    typedef std::priority_queue<DijkstraNode, std::vector<DijkstraNode>, 
+                                std::greater<DijkstraNode>> NodeQueue;
+    NodeQueue forwardQueue;
+    NodeQueue backwardQueue;
+    
+    forward.touch(source);
+    forward.distance[source] = 0.0;
+    forwardQueue.push(DijkstraNode(source, 0.0));
+    backward.touch(target);
+    backward.distance[target] = 0.0;
+    backwardQueue.push(DijkstraNode(target, 0.0));
+    
+    // Best complete path seen so far (mu) and the node where it meets
+    double best = (source == target) ? 0.0 : std::numeric_limits<double>::infinity();
+    uint32_t meeting = (source == target) ? source : CompactGraph::INVALID_NODE;
+    
+    while (!forwardQueue.empty() && !backwardQueue.empty()) {
+        // Stopping rule: no unsettled path can beat mu any more
+        if (forwardQueue.top().distance + backwardQueue.top().distance >= best) break;
         
-        std::reverse(path.begin(), path.end());
+        // Expand the side with the smaller frontier key
+        bool expandForward = forwardQueue.top().distance <= backwardQueue.top().distance;
+        NodeQueue& queue = expandForward ? forwardQueue : backwardQueue;
+        SearchSpace& self = expandForward ? forward : backward;
+        const SearchSpace& other = expandForward ? backward : forward;
         
-        result.path = path;
-        result.totalDistance = distances[end];
-        result.nodeCount = path.size();
+        DijkstraNode current = queue.top();
+        queue.pop();
+        
+        if (self.settled[current.id]) continue;
+        self.settled[current.id] = 1;
+        self.settledCount++;
+        
+        uint32_t begin = expandForward ? view.edgesBegin(current.id) : view.reverseBegin(current.id);
+        uint32_t end = expandForward ? view.edgesEnd(current.id) : view.reverseEnd(current.id);
+        for (uint32_t e = begin; e < end; e++) {
+            uint32_t next = expandForward ? view.edgeTarget(e) : view.reverseSource(e);
+            double newDist = current.distance + (expandForward ? view.edgeWeight(e) : view.reverseWeight(e));
+            
+            if (newDist < self.distance[next]) {
+                self.touch(next);
+                self.distance[next] = newDist;
+                self.previous[next] = current.id;
+                queue.push(DijkstraNode(next, newDist));
+            }
+            
+            if (newDist + other.distance[next] < best) {
+                best = newDist + other.distance[next];
+                meeting = next;
+            }
+        }
+    }
+    
+    return meeting;
+}
+
+const HierarchyStats& DijkstraRouter::buildContractionHierarchy() {
+    const CompactGraph& view = hospitalMap->getCompactView();
+    hierarchy.build(view);
+    hierarchyVersion = hospitalMap->getVersion();
+    hierarchyWarningShown = false;
+    return hierarchy.getStats();
+}
+
+bool DijkstraRouter::hasContractionHierarchy() const {
+    return hierarchy.isBuilt() && hierarchyVersion == hospitalMap->getVersion();
+}
+
+bool DijkstraRouter::usesBucketQueue() const {
+    return bucketQueueEnabled && hospitalMap->getCompactView().hasSmallIntegerWeights();
+}
+
+bool DijkstraRouter::validateHeuristic() const {
+    return hospitalMap->getCompactView().isEuclideanAdmissible();
+}
+
+RouteInfo DijkstraRouter::buildBidirectionalRoute(const CompactGraph& view, 
+                                                  const SearchSpace& forward,
+                                                  const SearchSpace& backward, uint32_t source,
+                                                  uint32_t target, uint32_t meeting) const {
+    RouteInfo result;
+    if (meeting == CompactGraph::INVALID_NODE) {
+        return result;
+    }
+    
+    // Source half from forward predecessors, target half from backward successors
+    for (uint32_t node = meeting; node != source; node = forward.previous[node]) {
+        result.path.push_back(view.nameOf(node));
+    }
+    result.path.push_back(view.nameOf(source));
+    std::reverse(result.path.begin(), result.path.end());
+    for (uint32_t node = meeting; node != target; ) {
+        node = backward.previous[node];
+        result.path.push_back(view.nameOf(node));
+    }
+    
+    result.totalDistance = forward.distance[meeting] + backward.distance[meeting];
+    result.nodeCount = result.path.size();
+    return result;
+}
+
+RouteInfo DijkstraRouter::buildRoute(const CompactGraph& view, const SearchSpace& space,
+                                     uint32_t source, uint32_t target) const {
+    RouteInfo result;
+    if (space.distance[target] == std::numeric_limits<double>::infinity()) {
+        return result;
+    }
+    
+    // Reconstruct path from the predecessor array
+    for (uint32_t node = target; node != source; node = space.previous[node]) {
+        result.path.push_back(view.nameOf(node));
+    }
+    result.path.push_back(view.nameOf(source));
+    std::reverse(result.path.begin(), result.path.end());
+    
+    result.totalDistance = space.distance[target];
+    result.nodeCount = result.path.size();
+    return result;
+}
+
+void DijkstraRouter::maintainShortestPathTree(const LocationId& source) {
+    if (!hospitalMap->hasNode(source)) {
+        std::cout << "Error: Source node not found in graph!\n";
+        return;
+    }
+    
+    ShortestPathTree& tree = maintainedTrees[source];
+    tree.build(*hospitalMap, hospitalMap->getCompactView().indexOf(source));
+    lastRepairCount = tree.getLastRelabelledCount();
+}
+
+void DijkstraRouter::releaseShortestPathTree(const LocationId& source) {
+    maintainedTrees.erase(source);
+    trimWeightLog();
+}
+
+bool DijkstraRouter::isTreeMaintained(const LocationId& source) const {
+    return maintainedTrees.find(source) != maintainedTrees.end();
+}
+
+ShortestPathTree* DijkstraRouter::findMaintainedTree(const LocationId& start) {
+    auto it = maintainedTrees.find(start);
+    if (it == maintainedTrees.end()) {
+        return nullptr;
     }
     
+    // Closures and reopenings since the last query are repaired here, lazily
+    if (!it->second.isSynchronized(*hospitalMap)) {
+        it->second.synchronize(*hospitalMap);
+        lastRepairCount = it->second.getLastRelabelledCount();
+        trimWeightLog();
+    }
+    return &it->second;
+}
+
+void DijkstraRouter::trimWeightLog() {
+    // Keep what the furthest-behind tree still has to read. A tree more than
+    // V changes behind is not waited for: replaying that many costs as much
+    // as the rebuild it gets instead.
+    uint64_t end = hospitalMap->getWeightLogEnd();
+    uint64_t backlogLimit = static_cast<uint64_t>(hospitalMap->getVertexCount());
+    uint64_t keepFrom = end;
+    for (const auto& entry : maintainedTrees) {
+        uint64_t position = entry.second.getLogPosition();
+        if (end - position <= backlogLimit) {
+            keepFrom = std::min(keepFrom, position);
+        }
+    }
+    hospitalMap->trimWeightLog(keepFrom);
+}
+
+RouteInfo DijkstraRouter::buildTreeRoute(const CompactGraph& view, const ShortestPathTree& tree,
+                                         uint32_t target) const {
+    RouteInfo result;
+    std::vector<uint32_t> nodes = tree.pathTo(target);
+    for (uint32_t node : nodes) {
+        result.path.push_back(view.nameOf(node));
+    }
+    if (!nodes.empty()) {
+        result.totalDistance = tree.distanceTo(target);
+        result.nodeCount = result.path.size();
+    }
     return result;
 }
 
+void DijkstraRouter::validateRouteCache() {
+    // Any mutation since the entries were stored makes all of them suspect
+    if (cacheVersion != hospitalMap->getVersion()) {
+        clearRouteCache();
+        cacheVersion = hospitalMap->getVersion();
+    }
+}
+
+const RouteInfo* DijkstraRouter::findCachedRoute(const RouteKey& key) {
+    validateRouteCache();
+    
+    auto it = routeCacheIndex.find(key);
+    if (it == routeCacheIndex.end()) {
+        return nullptr;
+    }
+    
+    // Move to the front: O(1) splice, iterators stay valid
+    routeCache.splice(routeCache.begin(), routeCache, it->second);
+    return &it->second->route;
+}
+
+void DijkstraRouter::storeCachedRoute(const RouteKey& key, const RouteInfo& route) {
+    if (routeCacheCapacity == 0) return;
+    
+    auto it = routeCacheIndex.find(key);
+    if (it != routeCacheIndex.end()) {
+        it->second->route = route;
+        routeCache.splice(routeCache.begin(), routeCache, it->second);
+        return;
+    }
+    
+    if (routeCache.size() >= routeCacheCapacity) {
+        routeCacheIndex.erase(routeCache.back().key);
+        routeCache.pop_back();
+    }
+    
+    CachedRoute entry;
+    entry.key = key;
+    entry.route = route;
+    routeCache.push_front(entry);
+    routeCacheIndex[key] = routeCache.begin();
+}
+
+void DijkstraRouter::clearRouteCache() {
+    routeCache.clear();
+    routeCacheIndex.clear();
+}
+
+void DijkstraRouter::setRouteCacheCapacity(size_t capacity) {
+    routeCacheCapacity = capacity;
+    while (routeCache.size() > routeCacheCapacity) {
+        routeCacheIndex.erase(routeCache.back().key);
+        routeCache.pop_back();
+    }
+}
+
+void DijkstraRouter::setRoutingMode(RoutingMode mode) {
+    // Modes agree on distance but may break ties between equal paths differently
+    if (mode != routingMode) {
+        clearRouteCache();
+    }
+    routingMode = mode;
+}
+
+RouteInfo DijkstraRouter::findShortestPath(const LocationId& start, const LocationId& end) {
+    RouteKey key(start, end);
+    const RouteInfo* cached = findCachedRoute(key);
+    if (cached) {
+        cacheHits++;
+        lastSettledCount = 0;
+        return *cached;
+    }
+    cacheMisses++;
+    
+    RouteInfo route;
+    ShortestPathTree* tree = findMaintainedTree(start);
+    if (tree && hospitalMap->hasNode(end)) {
+        const CompactGraph& view = hospitalMap->getCompactView();
+        route = buildTreeRoute(view, *tree, view.indexOf(end));
+        lastSettledCount = 0;
+    } else {
+        route = findShortestPath(start, end, routingMode);
+    }
+    
+    if (hospitalMap->hasNode(start) && hospitalMap->hasNode(end)) {
+        storeCachedRoute(key, route);
+    }
+    return route;
+}
+
+void DijkstraRouter::findShortestPath(const LocationId& start, const LocationId& end, RouteInfo& route) {
+    const RouteInfo* cached = findCachedRoute(RouteKey(start, end));
+    if (cached) {
+        cacheHits++;
+        lastSettledCount = 0;
+        route.path.assign(cached->path.begin(), cached->path.end());
+        route.totalDistance = cached->totalDistance;
+        route.nodeCount = cached->nodeCount;
+        return;
+    }
+    route = findShortestPath(start, end);
+}
+
+RoutingMode DijkstraRouter::resolveMode(const CompactGraph& view, RoutingMode mode) {
+    if (mode == RoutingMode::A_STAR && !view.isEuclideanAdmissible()) {
+        if (!heuristicWarningShown) {
+            std::cout << "Warning: corridor shorter than straight-line distance, "
+                      << "A* disabled (using Dijkstra)\n";
+            heuristicWarningShown = true;
+        }
+        mode = RoutingMode::DIJKSTRA;
+    }
+    
+    if (mode == RoutingMode::CONTRACTION_HIERARCHY && !hasContractionHierarchy()) {
+        if (!hierarchyWarningShown) {
+            std::cout << "Warning: contraction hierarchy missing or stale, "
+                      << "using bidirectional Dijkstra\n";
+            hierarchyWarningShown = true;
+        }
+        mode = RoutingMode::BIDIRECTIONAL;
+    }
+    return mode;
+}
+
+RouteInfo DijkstraRouter::computeRoute(const CompactGraph& view, uint32_t source, uint32_t target,
+                                       RoutingMode mode, SearchSpace& forward,
+                                       SearchSpace& backward, size_t& settled) const {
+    switch (mode) {
+        case RoutingMode::CONTRACTION_HIERARCHY: {
+            uint32_t meeting = hierarchy.query(source, target, forward, backward);
+            settled = forward.settledCount + backward.settledCount;
+            
+            RouteInfo result;
+            std::vector<uint32_t> nodes = hierarchy.unpackPath(source, target, meeting,
+                                                               forward, backward);
+            for (uint32_t node : nodes) {
+                result.path.push_back(view.nameOf(node));
+            }
+            if (!nodes.empty()) {
+                result.totalDistance = forward.distance[meeting] + backward.distance[meeting];
+                result.nodeCount = result.path.size();
+            }
+            return result;
+        }
+        case RoutingMode::BIDIRECTIONAL: {
+            uint32_t meeting = runBidirectional(view, source, target, forward, backward);
+            settled = forward.settledCount + backward.settledCount;
+            return buildBidirectionalRoute(view, forward, backward, source, target, meeting);
+        }
+        case RoutingMode::A_STAR:
+            runAStar(view, source, target, forward);
+            break;
+        case RoutingMode::DIJKSTRA:
+        default:
+            runDijkstra(view, source, std::vector<uint32_t>(1, target), forward);
+            break;
+    }
+    settled = forward.settledCount;
+    return buildRoute(view, forward, source, target);
+}
+
+RouteInfo DijkstraRouter::findShortestPath(const LocationId& start, const LocationId& end,
+                                           RoutingMode mode) {
+    if (!hospitalMap->hasNode(start) || !hospitalMap->hasNode(end)) {
+        std::cout << "Error: Start or end node not found in graph!\n";
+        return RouteInfo();
+    }
+    
+    // Run on the interned CSR view: dense arrays instead of string-keyed maps
+    const CompactGraph& view = hospitalMap->getCompactView();
+    return computeRoute(view, view.indexOf(start), view.indexOf(end), resolveMode(view, mode),
+                        searchSpace, backwardSpace, lastSettledCount);
+}
+
+std::vector<RouteInfo> DijkstraRouter::findShortestPathsBatch(
+    const std::vector<std::pair<LocationId, LocationId>>& queries) {
+    
+    std::vector<RouteInfo> routes(queries.size());
+    
+    // Everything that mutates router or graph state happens here, on the
+    // calling thread: CSR build, mode fallback, tree repair, cache lookups
+    const CompactGraph& view = hospitalMap->getCompactView();
+    RoutingMode mode = resolveMode(view, routingMode);
+    
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < queries.size(); i++) {
+        const LocationId& start = queries[i].first;
+        const LocationId& end = queries[i].second;
+        if (!hospitalMap->hasNode(start) || !hospitalMap->hasNode(end)) {
+            std::cout << "Error: Start or end node not found in graph!\n";
+            continue;
+        }
+        
+        const RouteInfo* cached = findCachedRoute(RouteKey(start, end));
+        ShortestPathTree* tree = cached ? nullptr : findMaintainedTree(start);
+        if (cached) {
+            cacheHits++;
+            routes[i] = *cached;
+        } else if (tree) {
+            cacheMisses++;
+            routes[i] = buildTreeRoute(view, *tree, view.indexOf(end));
+            storeCachedRoute(RouteKey(start, end), routes[i]);
+        } else {
+            cacheMisses++;
+            pending.push_back(i);
+        }
+    }
+    
+    // Workers pull the next query off a shared counter, so a few long routes
+    // can't leave the other threads idle. Graph and router are read-only here;
+    // each worker owns its search spaces and every output slot has one writer.
+    unsigned threads = batchThreadCount ? batchThreadCount : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(pending.size())));
+    
+    if (batchForward.size() < threads) {
+        batchForward.resize(threads);
+        batchBackward.resize(threads);
+    }
+    
+    std::atomic<size_t> nextQuery(0);
+    std::atomic<size_t> totalSettled(0);
+    batchPool.run(threads, [&](unsigned worker) {
+        SearchSpace& forward = batchForward[worker];
+        SearchSpace& backward = batchBackward[worker];
+        size_t settledHere = 0;
+        for (size_t k = nextQuery++; k < pending.size(); k = nextQuery++) {
+            size_t i = pending[k];
+            size_t settled = 0;
+            routes[i] = computeRoute(view, view.indexOf(queries[i].first), 
+                                     view.indexOf(queries[i].second), mode,
+                                     forward, backward, settled);
+            settledHere += settled;
+        }
+        totalSettled += settledHere;
+    });
+    lastSettledCount = totalSettled;
+    
+    for (size_t i : pending) {
+        storeCachedRoute(RouteKey(queries[i].first, queries[i].second), routes[i]);
+    }
+    return routes;
+}
+
 std::vector<RouteInfo> DijkstraRouter::findPathsToMultipleDestinations(
-    const std::string& start, 
-    const std::vector<std::string>& destinations) {
+    const LocationId& start, 
+    const std::vector<LocationId>& destinations) {
+    
+    std::vector<RouteInfo> routes(destinations.size());
+    if (!hospitalMap->hasNode(start)) {
+        std::cout << "Error: Start node not found in graph!\n";
+        return routes;
+    }
+    
+    const CompactGraph& view = hospitalMap->getCompactView();
+    uint32_t source = view.indexOf(start);
     
-    std::vector<RouteInfo> routes;
-    for (const std::string& dest : destinations) {
-        routes.push_back(findShortestPath(start, dest));
+    std::vector<uint32_t> targets;
+    targets.reserve(destinations.size());
+    for (const LocationId& dest : destinations) {
+        if (hospitalMap->hasNode(dest)) {
+            targets.push_back(view.indexOf(dest));
+        } else {
+            std::cout << "Error: Destination " << dest << " not found in graph!\n";
+        }
+    }
+    
+    // One search settles every destination; each route is read off the same
+    // tree. A maintained tree already covers them all.
+    ShortestPathTree* tree = findMaintainedTree(start);
+    if (!tree) {
+        runDijkstra(view, source, targets, searchSpace);
+        lastSettledCount = searchSpace.settledCount;
+    }
+    
+    // Every route off the tree is exact, so it can seed the point-to-point cache
+    validateRouteCache();
+    size_t next = 0;
+    for (size_t i = 0; i < destinations.size(); i++) {
+        if (hospitalMap->hasNode(destinations[i])) {
+            routes[i] = tree ? buildTreeRoute(view, *tree, targets[next++])
+                             : buildRoute(view, searchSpace, source, targets[next++]);
+            storeCachedRoute(RouteKey(start, destinations[i]), routes[i]);
+        }
     }
     return routes;
 }
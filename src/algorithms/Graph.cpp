@@ -3,41 +3,116 @@
 #include <iomanip>  // ADD THIS LINE
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
 
-Graph::Graph() : vertexCount(0), edgeCount(0) {}
+Graph::Graph() : vertexCount(0), edgeCount(0), version(0), topologyVersion(0), weightLogStart(0) {}
 
-void Graph::addNode(const std::string& nodeId, const Coordinates& position) {
+void Graph::addNode(const LocationId& nodeId, const Coordinates& position) {
     if (nodePositions.find(nodeId) == nodePositions.end()) {
         nodePositions[nodeId] = position;
-        adjacencyList[nodeId] = std::vector<Edge>();
+        adjacencyList[nodeId];
+        nodeOrder.push_back(nodeId);
         vertexCount++;
+        version++;
+        topologyVersion++;
+        trimWeightLog(getWeightLogEnd());
+        compactView.reset();
     }
 }
 
-void Graph::addEdge(const std::string& from, const std::string& to, double weight) {
+// A negative corridor breaks every Dijkstra variant; NaN never compares
+// equal, so it would be re-patched and re-logged on every update
+static void checkWeight(double weight) {
+    if (std::isnan(weight) || weight < 0.0) {
+        throw std::invalid_argument("Corridor weight must be a non-negative number!");
+    }
+}
+
+void Graph::addEdge(const LocationId& from, const LocationId& to, double weight) {
+    checkWeight(weight);
     adjacencyList[from].push_back(Edge(from, to, weight));
     edgeCount++;
+    version++;
+    topologyVersion++;
+    trimWeightLog(getWeightLogEnd());
+    compactView.reset();
 }
 
-void Graph::addBidirectionalEdge(const std::string& node1, const std::string& node2, double weight) {
+void Graph::addBidirectionalEdge(const LocationId& node1, const LocationId& node2, double weight) {
     addEdge(node1, node2, weight);
     addEdge(node2, node1, weight);
 }
 
-std::vector<Edge> Graph::getEdges(const std::string& node) const {
+template <typename Fn>
+int Graph::forEachEdge(const LocationId& from, const LocationId& to, Fn fn) {
+    auto it = adjacencyList.find(from);
+    if (it == adjacencyList.end()) return 0;
+    
+    int found = 0;
+    for (size_t i = 0; i < it->second.size(); i++) {
+        Edge& edge = it->second[i];
+        if (edge.to != to) continue;
+        
+        double oldWeight = edge.effectiveWeight();
+        fn(edge);
+        if (edge.effectiveWeight() != oldWeight) {
+            patchEdgeWeight(from, i, oldWeight, edge.effectiveWeight());
+        }
+        found++;
+    }
+    return found;
+}
+
+void Graph::patchEdgeWeight(const LocationId& from, size_t position, 
+                            double oldWeight, double newWeight) {
+    // The i-th edge in from's list occupies slot offsets[from] + i of the CSR
+    getCompactView();
+    CompactGraph& view = *compactView;
+    uint32_t source = view.indexOf(from);
+    uint32_t edge = view.edgesBegin(source) + static_cast<uint32_t>(position);
+    view.patchEdgeWeight(source, edge, newWeight);
+    weightLog.push_back(WeightChange(source, edge, oldWeight, newWeight));
+    version++;
+    
+    // Whether or not any tree reads the log, keep at most the last 2V
+    // changes: a reader more than V behind rebuilds rather than replaying
+    uint64_t keep = static_cast<uint64_t>(vertexCount);
+    if (weightLog.size() > 2 * keep) {
+        trimWeightLog(getWeightLogEnd() - keep);
+    }
+}
+
+void Graph::trimWeightLog(uint64_t position) {
+    if (position <= weightLogStart) return;
+    size_t dropped = static_cast<size_t>(std::min<uint64_t>(position - weightLogStart, weightLog.size()));
+    weightLog.erase(weightLog.begin(), weightLog.begin() + dropped);
+    weightLogStart += dropped;
+}
+
+bool Graph::updateEdgeWeight(const LocationId& from, const LocationId& to, double weight) {
+    checkWeight(weight);
+    return forEachEdge(from, to, [weight](Edge& edge) { edge.weight = weight; }) > 0;
+}
+
+bool Graph::disableEdge(const LocationId& from, const LocationId& to) {
+    return forEachEdge(from, to, [](Edge& edge) { edge.open = false; }) > 0;
+}
+
+bool Graph::enableEdge(const LocationId& from, const LocationId& to) {
+    return forEachEdge(from, to, [](Edge& edge) { edge.open = true; }) > 0;
+}
+
+const std::vector<Edge>& Graph::getEdges(const LocationId& node) const {
+    static const std::vector<Edge> noEdges;
     auto it = adjacencyList.find(node);
     if (it != adjacencyList.end()) {
         return it->second;
     }
-    return std::vector<Edge>();
+    return noEdges;
 }
 
-std::vector<std::string> Graph::getAllNodes() const {
-    std::vector<std::string> nodes;
-    for (const auto& pair : nodePositions) {
-        nodes.push_back(pair.first);
-    }
-    return nodes;
+const std::vector<LocationId>& Graph::getAllNodes() const {
+    return nodeOrder;
 }
 
 std::vector<Edge> Graph::getAllEdges() const {
@@ -50,7 +125,7 @@ std::vector<Edge> Graph::getAllEdges() const {
     return allEdges;
 }
 
-Coordinates Graph::getNodePosition(const std::string& node) const {
+Coordinates Graph::getNodePosition(const LocationId& node) const {
     auto it = nodePositions.find(node);
     if (it != nodePositions.end()) {
         return it->second;
@@ -58,11 +133,18 @@ Coordinates Graph::getNodePosition(const std::string& node) const {
     return Coordinates();
 }
 
-bool Graph::hasNode(const std::string& node) const {
+bool Graph::hasNode(const LocationId& node) const {
     return nodePositions.find(node) != nodePositions.end();
 }
 
-double Graph::calculateEuclideanDistance(const std::string& node1, const std::string& node2) const {
+const CompactGraph& Graph::getCompactView() const {
+    if (!compactView) {
+        compactView.reset(new CompactGraph(*this));
+    }
+    return *compactView;
+}
+
+double Graph::calculateEuclideanDistance(const LocationId& node1, const LocationId& node2) const {
     Coordinates pos1 = getNodePosition(node1);
     Coordinates pos2 = getNodePosition(node2);
     
@@ -84,7 +166,7 @@ void Graph::display() const {
     for (const auto& pair : adjacencyList) {
         std::cout << pair.first << " → ";
         for (const Edge& edge : pair.second) {
-            std::cout << edge.to << "(" << edge.weight << "m) ";
+            std::cout << edge.to << "(" << edge.weight << "m" << (edge.open ? "" : ", closed") << ") ";
         }
         std::cout << "\n";
     }
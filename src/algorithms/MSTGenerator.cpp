@@ -2,23 +2,24 @@
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 
 // UnionFind Implementation
-void UnionFind::makeSet(const std::string& node) {
+void UnionFind::makeSet(const LocationId& node) {
     parent[node] = node;
     rank[node] = 0;
 }
 
-std::string UnionFind::find(const std::string& node) {
+LocationId UnionFind::find(const LocationId& node) {
     if (parent[node] != node) {
         parent[node] = find(parent[node]); // Path compression
     }
     return parent[node];
 }
 
-bool UnionFind::unionSets(const std::string& node1, const std::string& node2) {
-    std::string root1 = find(node1);
-    std::string root2 = find(node2);
+bool UnionFind::unionSets(const LocationId& node1, const LocationId& node2) {
+    LocationId root1 = find(node1);
+    LocationId root2 = find(node2);
     
     if (root1 == root2) return false; // Already in same set
     
@@ -35,27 +36,74 @@ bool UnionFind::unionSets(const std::string& node1, const std::string& node2) {
     return true;
 }
 
+// IndexedUnionFind Implementation
+IndexedUnionFind::IndexedUnionFind(uint32_t nodeCount) 
+    : parent(nodeCount), rank(nodeCount, 0) {
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        parent[i] = i;
+    }
+}
+
+uint32_t IndexedUnionFind::find(uint32_t node) {
+    while (parent[node] != node) {
+        parent[node] = parent[parent[node]]; // Path halving
+        node = parent[node];
+    }
+    return node;
+}
+
+bool IndexedUnionFind::unionSets(uint32_t node1, uint32_t node2) {
+    uint32_t root1 = find(node1);
+    uint32_t root2 = find(node2);
+    
+    if (root1 == root2) return false;
+    
+    if (rank[root1] < rank[root2]) {
+        parent[root1] = root2;
+    } else if (rank[root1] > rank[root2]) {
+        parent[root2] = root1;
+    } else {
+        parent[root2] = root1;
+        rank[root1]++;
+    }
+    
+    return true;
+}
+
 // MSTGenerator Implementation
 MSTGenerator::MSTGenerator(Graph* graph) : equipmentGraph(graph) {}
 
 MSTResult MSTGenerator::generateMinimumSpanningTree() {
     MSTResult result;
     
-    // Get all edges and sort by weight - O(E log E)
-    std::vector<Edge> allEdges = equipmentGraph->getAllEdges();
-    std::sort(allEdges.begin(), allEdges.end());
+    const CompactGraph& view = equipmentGraph->getCompactView();
     
-    // Initialize Union-Find
-    UnionFind uf;
-    for (const std::string& node : equipmentGraph->getAllNodes()) {
-        uf.makeSet(node);
+    // Sort CSR edge slots by weight - O(E log E); only indices move around
+    std::vector<uint32_t> order(view.getEdgeCount());
+    std::vector<uint32_t> edgeSource(view.getEdgeCount());
+    for (uint32_t u = 0; u < view.getNodeCount(); u++) {
+        for (uint32_t e = view.edgesBegin(u); e < view.edgesEnd(u); e++) {
+            order[e] = e;
+            edgeSource[e] = u;
+        }
     }
+    std::sort(order.begin(), order.end(), [&view](uint32_t a, uint32_t b) {
+        return view.edgeWeight(a) < view.edgeWeight(b);
+    });
+    
+    // Initialize Union-Find
+    IndexedUnionFind uf(view.getNodeCount());
     
     // Kruskal's Algorithm
-    for (const Edge& edge : allEdges) {
-        if (uf.unionSets(edge.from, edge.to)) {
-            result.edges.push_back(edge);
-            result.totalWeight += edge.weight;
+    for (uint32_t e : order) {
+        // Closed corridors sort last and can't carry equipment runs
+        if (view.edgeWeight(e) == std::numeric_limits<double>::infinity()) break;
+        
+        uint32_t from = edgeSource[e];
+        uint32_t to = view.edgeTarget(e);
+        if (uf.unionSets(from, to)) {
+            result.edges.push_back(Edge(view.nameOf(from), view.nameOf(to), view.edgeWeight(e)));
+            result.totalWeight += view.edgeWeight(e);
             result.edgeCount++;
             
             // MST has V-1 edges
@@ -74,7 +122,7 @@ double MSTGenerator::calculateOptimizationPercentage(const MSTResult& mst) const
     double totalPossibleWeight = 0.0;
     
     for (const Edge& edge : allEdges) {
-        totalPossibleWeight += edge.weight;
+        if (edge.open) totalPossibleWeight += edge.weight;
     }
     
     double savings = ((totalPossibleWeight - mst.totalWeight) / totalPossibleWeight) * 100.0;
@@ -9,7 +9,7 @@ void QuickSorter::sortPatientsByID(std::vector<Patient>& patients) {
 }
 
 int QuickSorter::partition(std::vector<Patient>& patients, int low, int high) {
-    std::string pivot = patients[high].getPatientID();
+    const PatientId pivot = patients[high].getPatientID();     // inline copy; the slot moves during swaps
     int i = low - 1;
     
     for (int j = low; j < high; j++) {
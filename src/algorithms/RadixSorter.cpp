@@ -30,9 +30,9 @@ void RadixSorter::countingSortByPosition(std::vector<Patient>& patients, int pos
     
     // Count occurrences
     for (const Patient& p : patients) {
-        std::string id = p.getPatientID();
+        const PatientId& id = p.getPatientID();
         int charIndex = id.length() - 1 - position;
-        int charValue = (charIndex >= 0) ? static_cast<int>(id[charIndex]) : 0;
+        int charValue = (charIndex >= 0) ? static_cast<unsigned char>(id[charIndex]) : 0;
         count[charValue]++;
     }
     
@@ -43,9 +43,9 @@ void RadixSorter::countingSortByPosition(std::vector<Patient>& patients, int pos
     
     // Build output array
     for (int i = patients.size() - 1; i >= 0; i--) {
-        std::string id = patients[i].getPatientID();
+        const PatientId& id = patients[i].getPatientID();
         int charIndex = id.length() - 1 - position;
-        int charValue = (charIndex >= 0) ? static_cast<int>(id[charIndex]) : 0;
+        int charValue = (charIndex >= 0) ? static_cast<unsigned char>(id[charIndex]) : 0;
         output[count[charValue] - 1] = patients[i];
         count[charValue]--;
     }
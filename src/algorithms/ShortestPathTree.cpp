@@ -0,0 +1,166 @@
+#include "../../include/algorithms/ShortestPathTree.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+ShortestPathTree::ShortestPathTree()
+    : source(CompactGraph::INVALID_NODE), topologyVersion(0), logPosition(0), lastRelabelled(0) {}
+
+void ShortestPathTree::build(const Graph& graph, uint32_t sourceNode) {
+    source = sourceNode;
+    rebuild(graph.getCompactView());
+    topologyVersion = graph.getTopologyVersion();
+    logPosition = graph.getWeightLogEnd();
+}
+
+void ShortestPathTree::synchronize(const Graph& graph) {
+    if (topologyVersion != graph.getTopologyVersion() || logPosition < graph.getWeightLogStart()) {
+        // Slots in the log no longer line up with ours, or changes we never
+        // read were trimmed - start over
+        build(graph, source);
+        return;
+    }
+
+    if (logPosition < graph.getWeightLogEnd()) {
+        repair(graph.getCompactView(), graph.getWeightLog(),
+               static_cast<size_t>(logPosition - graph.getWeightLogStart()));
+        logPosition = graph.getWeightLogEnd();
+    }
+}
+
+bool ShortestPathTree::isSynchronized(const Graph& graph) const {
+    return topologyVersion == graph.getTopologyVersion()
+        && logPosition == graph.getWeightLogEnd();
+}
+
+void ShortestPathTree::relabel(uint32_t node, double dist, uint32_t from, uint32_t edge) {
+    distance[node] = dist;
+    parent[node] = from;
+    parentEdge[node] = edge;
+    heap.push_back(std::make_pair(dist, node));
+    std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<double, uint32_t> >());
+}
+
+void ShortestPathTree::propagate(const CompactGraph& view) {
+    // Plain Dijkstra from whatever labels are queued; every other label is
+    // already consistent, so only the region that actually changes is visited
+    std::greater<std::pair<double, uint32_t> > later;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        double dist = heap.back().first;
+        uint32_t node = heap.back().second;
+        heap.pop_back();
+
+        if (dist != distance[node]) continue;     // superseded entry
+        lastRelabelled++;
+
+        for (uint32_t e = view.edgesBegin(node); e < view.edgesEnd(node); e++) {
+            uint32_t next = view.edgeTarget(e);
+            double newDist = dist + view.edgeWeight(e);
+            if (newDist < distance[next]) {
+                relabel(next, newDist, node, e);
+            }
+        }
+    }
+}
+
+void ShortestPathTree::rebuild(const CompactGraph& view) {
+    distance.assign(view.getNodeCount(), std::numeric_limits<double>::infinity());
+    parent.assign(view.getNodeCount(), CompactGraph::INVALID_NODE);
+    parentEdge.assign(view.getNodeCount(), CompactGraph::INVALID_NODE);
+    affected.assign(view.getNodeCount(), 0);
+    heap.clear();
+    lastRelabelled = 0;
+
+    relabel(source, 0.0, CompactGraph::INVALID_NODE, CompactGraph::INVALID_NODE);
+    propagate(view);
+}
+
+void ShortestPathTree::repair(const CompactGraph& view, const std::vector<WeightChange>& log, size_t first) {
+    heap.clear();
+    affectedNodes.clear();
+    lastRelabelled = 0;
+
+    // 1. A tree edge that got longer (or closed) invalidates every label below
+    //    it. Collect those subtrees: children are the targets whose tree edge
+    //    is one of our outgoing slots.
+    for (size_t i = first; i < log.size(); i++) {
+        const WeightChange& change = log[i];
+        uint32_t head = view.edgeTarget(change.edge);
+        if (change.newWeight <= change.oldWeight || parentEdge[head] != change.edge) continue;
+        if (affected[head]) continue;
+
+        size_t subtreeStart = affectedNodes.size();
+        affected[head] = 1;
+        affectedNodes.push_back(head);
+        for (size_t k = subtreeStart; k < affectedNodes.size(); k++) {
+            uint32_t node = affectedNodes[k];
+            for (uint32_t e = view.edgesBegin(node); e < view.edgesEnd(node); e++) {
+                uint32_t child = view.edgeTarget(e);
+                if (parentEdge[child] == e && !affected[child]) {
+                    affected[child] = 1;
+                    affectedNodes.push_back(child);
+                }
+            }
+        }
+    }
+
+    for (uint32_t node : affectedNodes) {
+        distance[node] = std::numeric_limits<double>::infinity();
+        parent[node] = CompactGraph::INVALID_NODE;
+        parentEdge[node] = CompactGraph::INVALID_NODE;
+    }
+
+    // 2. Re-seed each invalidated node from its best intact in-neighbour
+    for (uint32_t node : affectedNodes) {
+        double best = std::numeric_limits<double>::infinity();
+        uint32_t bestFrom = CompactGraph::INVALID_NODE;
+        uint32_t bestEdge = CompactGraph::INVALID_NODE;
+        for (uint32_t slot = view.reverseBegin(node); slot < view.reverseEnd(node); slot++) {
+            uint32_t from = view.reverseSource(slot);
+            if (affected[from]) continue;
+
+            double dist = distance[from] + view.reverseWeight(slot);
+            if (dist < best) {
+                best = dist;
+                bestFrom = from;
+                bestEdge = view.reverseEdge(slot);
+            }
+        }
+        if (best < std::numeric_limits<double>::infinity()) {
+            relabel(node, best, bestFrom, bestEdge);
+        }
+    }
+    for (uint32_t node : affectedNodes) {
+        affected[node] = 0;
+    }
+
+    // 3. An edge that got shorter (or reopened) can only improve its head
+    for (size_t i = first; i < log.size(); i++) {
+        const WeightChange& change = log[i];
+        if (change.newWeight >= change.oldWeight) continue;
+
+        uint32_t head = view.edgeTarget(change.edge);
+        double dist = distance[change.from] + view.edgeWeight(change.edge);
+        if (dist < distance[head]) {
+            relabel(head, dist, change.from, change.edge);
+        }
+    }
+
+    // 4. Settle the queued labels outwards
+    propagate(view);
+}
+
+std::vector<uint32_t> ShortestPathTree::pathTo(uint32_t node) const {
+    std::vector<uint32_t> path;
+    if (distance[node] == std::numeric_limits<double>::infinity()) {
+        return path;
+    }
+
+    for (uint32_t current = node; current != source; current = parent[current]) {
+        path.push_back(current);
+    }
+    path.push_back(source);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -6,7 +6,7 @@ HospitalRoom::HospitalRoom()
     : roomID("R000"), type(RoomType::WARD), position(),
       occupied(false), capacity(1), currentOccupancy(0) {}
 
-HospitalRoom::HospitalRoom(const std::string& id, RoomType t, Coordinates pos, int cap)
+HospitalRoom::HospitalRoom(const LocationId& id, RoomType t, Coordinates pos, int cap)
     : roomID(id), type(t), position(pos),
       occupied(false), capacity(cap), currentOccupancy(0) {}
 
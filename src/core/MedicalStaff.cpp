@@ -6,17 +6,17 @@ MedicalStaff::MedicalStaff()
       currentLocation("STATION"), status(AvailabilityStatus::AVAILABLE),
       assignedPatientID("") {}
 
-MedicalStaff::MedicalStaff(const std::string& id, const std::string& staffName, StaffRole r)
+MedicalStaff::MedicalStaff(const StaffId& id, const std::string& staffName, StaffRole r)
     : staffID(id), name(staffName), role(r), currentLocation("STATION"),
       status(AvailabilityStatus::AVAILABLE), assignedPatientID("") {}
 
-void MedicalStaff::assignToPatient(const std::string& patientID) {
+void MedicalStaff::assignToPatient(const PatientId& patientID) {
     assignedPatientID = patientID;
     status = AvailabilityStatus::BUSY;
 }
 
 void MedicalStaff::clearAssignment() {
-    assignedPatientID = "";
+    assignedPatientID = PatientId();
     status = AvailabilityStatus::AVAILABLE;
 }
 
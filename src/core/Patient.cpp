@@ -1,12 +1,15 @@
 #include "../../include/core/Patient.hpp"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+
+const int Patient::SECONDS_PER_SEVERITY_POINT;
 
 Patient::Patient() 
     : patientID("P000"), severityScore(0), arrivalTime(std::time(nullptr)),
       location("ENTRANCE"), vitalSigns(), status(TriageStatus::PENDING) {}
 
-Patient::Patient(const std::string& id, const VitalSigns& vitals, const std::string& loc)
+Patient::Patient(const PatientId& id, const VitalSigns& vitals, const LocationId& loc)
     : patientID(id), severityScore(0), arrivalTime(std::time(nullptr)),
       location(loc), vitalSigns(vitals), status(TriageStatus::PENDING) {
     updateSeverity();
@@ -17,25 +20,35 @@ void Patient::setVitalSigns(const VitalSigns& vitals) {
     updateSeverity();
 }
 
-int Patient::calculateSeverity() const {
+int Patient::baseSeverityOf(const VitalSigns& vitals) {
     int score = 100;
     
-    if (vitalSigns.heartRate < 50 || vitalSigns.heartRate > 120) score -= 30;
-    else if (vitalSigns.heartRate < 60 || vitalSigns.heartRate > 100) score -= 15;
-    
-    if (vitalSigns.bloodPressure < 90 || vitalSigns.bloodPressure > 160) score -= 25;
-    else if (vitalSigns.bloodPressure < 100 || vitalSigns.bloodPressure > 140) score -= 10;
+    if (vitals.heartRate < 50 || vitals.heartRate > 120) score -= 30;
+    else if (vitals.heartRate < 60 || vitals.heartRate > 100) score -= 15;
     
-    if (vitalSigns.oxygenLevel < 90) score -= 35;
-    else if (vitalSigns.oxygenLevel < 95) score -= 20;
+    if (vitals.bloodPressure < 90 || vitals.bloodPressure > 160) score -= 25;
+    else if (vitals.bloodPressure < 100 || vitals.bloodPressure > 140) score -= 10;
     
-    if (vitalSigns.temperature > 39.0 || vitalSigns.temperature < 35.0) score -= 15;
+    if (vitals.oxygenLevel < 90) score -= 35;
+    else if (vitals.oxygenLevel < 95) score -= 20;
     
-    time_t currentTime = std::time(nullptr);
-    int waitMinutes = static_cast<int>((currentTime - arrivalTime) / 60);
-    score -= (waitMinutes / 10);
+    if (vitals.temperature > 39.0 || vitals.temperature < 35.0) score -= 15;
     
-    return std::max(0, score);
+    return score;
+}
+
+int Patient::agedSeverity(int baseSeverity, time_t arrival, time_t now) {
+    long long waited = static_cast<long long>(now - arrival);
+    int waitPoints = waited > 0 ? static_cast<int>(waited / SECONDS_PER_SEVERITY_POINT) : 0;
+    return std::max(0, baseSeverity - waitPoints);
+}
+
+int Patient::calculateSeverityAt(time_t now) const {
+    return agedSeverity(calculateBaseSeverity(), arrivalTime, now);
+}
+
+int Patient::calculateSeverity() const {
+    return calculateSeverityAt(std::time(nullptr));
 }
 
 void Patient::updateSeverity() {
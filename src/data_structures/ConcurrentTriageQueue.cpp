@@ -0,0 +1,99 @@
+#include "../../include/data_structures/ConcurrentTriageQueue.hpp"
+#include <thread>
+#include <functional>
+#include <algorithm>
+
+const uint64_t ConcurrentTriageQueue::EMPTY_KEY;
+
+// Per-thread xorshift state: shard picks must not contend on a shared RNG
+static uint32_t nextRandom() {
+    static std::atomic<uint32_t> seedSequence(0x9E3779B9u);
+    static thread_local uint32_t state = 0;
+    if (state == 0) {
+        state = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()))
+              ^ seedSequence.fetch_add(0x9E3779B9u, std::memory_order_relaxed);
+        if (state == 0) state = 1;
+    }
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+ConcurrentTriageQueue::ConcurrentTriageQueue(unsigned shardCount)
+    : nextArrival(0), pendingCount(0), processedCount(0) {
+    if (shardCount == 0) {
+        shardCount = 2 * std::thread::hardware_concurrency();
+        if (shardCount < 4) shardCount = 4;
+    }
+    shards.reserve(shardCount);
+    for (unsigned i = 0; i < shardCount; i++) {
+        shards.push_back(std::unique_ptr<Shard>(new Shard()));
+    }
+}
+
+size_t ConcurrentTriageQueue::randomShard() const {
+    return nextRandom() % shards.size();
+}
+
+void ConcurrentTriageQueue::addPatient(const Patient& patient) {
+    uint64_t arrival = nextArrival.fetch_add(1, std::memory_order_relaxed);
+    uint64_t key = (static_cast<uint64_t>(patient.getSeverityScore()) << 48)
+                 | (arrival & 0xFFFFFFFFFFFFULL);
+    Entry entry(key, patient);
+    
+    // Any uncontended shard will do; only block after a few busy ones
+    for (int attempt = 0; ; attempt++) {
+        Shard& shard = *shards[randomShard()];
+        if (attempt < 4) {
+            if (!shard.lock.try_lock()) continue;
+        } else {
+            shard.lock.lock();
+        }
+        shard.heap.insert(entry);
+        shard.refreshTop();
+        shard.lock.unlock();
+        break;
+    }
+    pendingCount.fetch_add(1, std::memory_order_release);
+}
+
+bool ConcurrentTriageQueue::popFrom(Shard& shard, Patient& patient) {
+    if (shard.heap.isEmpty()) return false;
+    
+    patient = shard.heap.extractMin().patient;
+    shard.refreshTop();
+    pendingCount.fetch_sub(1, std::memory_order_relaxed);
+    processedCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool ConcurrentTriageQueue::tryGetNextPatient(Patient& patient) {
+    // Two-choice pops: compare the cached tops of two random shards
+    size_t attempts = 2 * shards.size();
+    for (size_t attempt = 0; attempt < attempts; attempt++) {
+        if (pendingCount.load(std::memory_order_acquire) <= 0) return false;
+        
+        Shard& first = *shards[randomShard()];
+        Shard& second = *shards[randomShard()];
+        uint64_t firstKey = first.topKey.load(std::memory_order_acquire);
+        uint64_t secondKey = second.topKey.load(std::memory_order_acquire);
+        Shard& best = (firstKey <= secondKey) ? first : second;
+        if (std::min(firstKey, secondKey) == EMPTY_KEY) continue;
+        if (!best.lock.try_lock()) continue;
+        
+        bool popped = popFrom(best, patient);
+        best.lock.unlock();
+        if (popped) return true;
+    }
+    
+    // Mostly-empty queue: random picks keep missing, so sweep every shard
+    for (size_t i = 0; i < shards.size(); i++) {
+        Shard& shard = *shards[i];
+        if (shard.topKey.load(std::memory_order_acquire) == EMPTY_KEY) continue;
+        
+        std::lock_guard<std::mutex> guard(shard.lock);
+        if (popFrom(shard, patient)) return true;
+    }
+    return false;
+}
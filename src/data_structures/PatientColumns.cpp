@@ -0,0 +1,304 @@
+#include "../../include/data_structures/PatientColumns.hpp"
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define PATIENT_COLUMNS_X86 1
+#endif
+
+void PatientColumns::reserve(size_t patients) {
+    heartRate.reserve(patients);
+    bloodPressure.reserve(patients);
+    oxygenLevel.reserve(patients);
+    temperature.reserve(patients);
+    arrivalTime.reserve(patients);
+}
+
+size_t PatientColumns::append(const Patient& patient) {
+    const VitalSigns& vitals = patient.getVitalSigns();
+    heartRate.push_back(vitals.heartRate);
+    bloodPressure.push_back(vitals.bloodPressure);
+    oxygenLevel.push_back(vitals.oxygenLevel);
+    temperature.push_back(vitals.temperature);
+    arrivalTime.push_back(static_cast<int64_t>(patient.getArrivalTime()));
+    return size() - 1;
+}
+
+void PatientColumns::append(const std::vector<Patient>& patients) {
+    reserve(size() + patients.size());
+    for (const Patient& patient : patients) {
+        append(patient);
+    }
+}
+
+void PatientColumns::setVitals(size_t row, const VitalSigns& vitals) {
+    heartRate[row] = vitals.heartRate;
+    bloodPressure[row] = vitals.bloodPressure;
+    oxygenLevel[row] = vitals.oxygenLevel;
+    temperature[row] = vitals.temperature;
+}
+
+void PatientColumns::clear() {
+    heartRate.clear();
+    bloodPressure.clear();
+    oxygenLevel.clear();
+    temperature.clear();
+    arrivalTime.clear();
+}
+
+VitalSigns PatientColumns::vitalsAt(size_t row) const {
+    VitalSigns vitals;
+    vitals.heartRate = heartRate[row];
+    vitals.bloodPressure = bloodPressure[row];
+    vitals.oxygenLevel = oxygenLevel[row];
+    vitals.temperature = temperature[row];
+    return vitals;
+}
+
+// Column pointers for one batch, already offset to its first row
+struct ScoringBatch {
+    const int32_t* heartRate;
+    const int32_t* bloodPressure;
+    const int32_t* oxygenLevel;
+    const double* temperature;
+    const int64_t* arrivalTime;
+};
+
+static void scoreScalar(const ScoringBatch& batch, size_t first, size_t count, int64_t now, int32_t* out) {
+    for (size_t i = first; i < count; i++) {
+        VitalSigns vitals;
+        vitals.heartRate = batch.heartRate[i];
+        vitals.bloodPressure = batch.bloodPressure[i];
+        vitals.oxygenLevel = batch.oxygenLevel[i];
+        vitals.temperature = batch.temperature[i];
+        out[i] = Patient::agedSeverity(Patient::baseSeverityOf(vitals), static_cast<time_t>(batch.arrivalTime[i]),
+                                       static_cast<time_t>(now));
+    }
+}
+
+#ifdef PATIENT_COLUMNS_X86
+// How the vector kernels match Patient::baseSeverityOf and agedSeverity:
+//
+// Each rule's severe band lies inside its mild band, so "severe ? 30 : mild
+// ? 15 : 0" is (severe & 15) + (mild & 15), and likewise 25 = 15 + 10 and
+// 35 = 15 + 20. Temperature compares are ordered, so NaN costs nothing,
+// as in the scalar code.
+//
+// Any score minus 200 wait points is below zero, so the wait can be
+// clamped to 0..WAIT_CAP seconds before dividing. That keeps it in 32 bits,
+// and x / 600 becomes ((x >> 3) * 27963) >> 21, which is exact for
+// x >> 3 < 28728 and fits one multiply-add of 16-bit halves.
+static const int32_t WAIT_CAP = 200 * Patient::SECONDS_PER_SEVERITY_POINT;
+static const int32_t DIVIDE_BY_75 = 27963;
+
+__attribute__((target("sse2")))
+static void scoreSse2(const ScoringBatch& batch, size_t count, int64_t now, int32_t* out) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i fifteen = _mm_set1_epi32(15);
+    const __m128i nowWide = _mm_set1_epi64x(now);
+    const __m128i cap = _mm_set1_epi32(WAIT_CAP);
+    const __m128d feverAbove = _mm_set1_pd(39.0);
+    const __m128d chillBelow = _mm_set1_pd(35.0);
+    
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i heart = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.heartRate + i));
+        __m128i pressure = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.bloodPressure + i));
+        __m128i oxygen = _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.oxygenLevel + i));
+        
+        __m128i heartSevere = _mm_or_si128(_mm_cmplt_epi32(heart, _mm_set1_epi32(50)),
+                                           _mm_cmpgt_epi32(heart, _mm_set1_epi32(120)));
+        __m128i heartMild = _mm_or_si128(_mm_cmplt_epi32(heart, _mm_set1_epi32(60)),
+                                         _mm_cmpgt_epi32(heart, _mm_set1_epi32(100)));
+        __m128i pressureSevere = _mm_or_si128(_mm_cmplt_epi32(pressure, _mm_set1_epi32(90)),
+                                              _mm_cmpgt_epi32(pressure, _mm_set1_epi32(160)));
+        __m128i pressureMild = _mm_or_si128(_mm_cmplt_epi32(pressure, _mm_set1_epi32(100)),
+                                            _mm_cmpgt_epi32(pressure, _mm_set1_epi32(140)));
+        __m128i oxygenSevere = _mm_cmplt_epi32(oxygen, _mm_set1_epi32(90));
+        __m128i oxygenMild = _mm_cmplt_epi32(oxygen, _mm_set1_epi32(95));
+        
+        // Two doubles per register; keep the low half of each 64-bit mask
+        __m128d low = _mm_loadu_pd(batch.temperature + i);
+        __m128d high = _mm_loadu_pd(batch.temperature + i + 2);
+        __m128d lowOut = _mm_or_pd(_mm_cmpgt_pd(low, feverAbove), _mm_cmplt_pd(low, chillBelow));
+        __m128d highOut = _mm_or_pd(_mm_cmpgt_pd(high, feverAbove), _mm_cmplt_pd(high, chillBelow));
+        __m128i temperatureOut = _mm_castps_si128(_mm_shuffle_ps(_mm_castpd_ps(lowOut), _mm_castpd_ps(highOut),
+                                                                 _MM_SHUFFLE(2, 0, 2, 0)));
+        
+        __m128i penalty = _mm_add_epi32(_mm_and_si128(heartSevere, fifteen), _mm_and_si128(heartMild, fifteen));
+        penalty = _mm_add_epi32(penalty, _mm_and_si128(pressureSevere, fifteen));
+        penalty = _mm_add_epi32(penalty, _mm_and_si128(pressureMild, _mm_set1_epi32(10)));
+        penalty = _mm_add_epi32(penalty, _mm_and_si128(oxygenSevere, fifteen));
+        penalty = _mm_add_epi32(penalty, _mm_and_si128(oxygenMild, _mm_set1_epi32(20)));
+        penalty = _mm_add_epi32(penalty, _mm_and_si128(temperatureOut, fifteen));
+        
+        // Waits in 64 bits, split into 32-bit low and high words
+        __m128i waitedA = _mm_sub_epi64(nowWide, _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.arrivalTime + i)));
+        __m128i waitedB = _mm_sub_epi64(nowWide, _mm_loadu_si128(reinterpret_cast<const __m128i*>(batch.arrivalTime + i + 2)));
+        __m128i waitLow = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(waitedA), _mm_castsi128_ps(waitedB),
+                                                          _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i waitHigh = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(waitedA), _mm_castsi128_ps(waitedB),
+                                                           _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128i early = _mm_cmplt_epi32(waitHigh, zero);
+        __m128i capped = _mm_or_si128(_mm_cmpgt_epi32(waitHigh, zero),
+                                      _mm_or_si128(_mm_cmplt_epi32(waitLow, zero), _mm_cmpgt_epi32(waitLow, cap)));
+        __m128i waited = _mm_or_si128(_mm_andnot_si128(capped, waitLow), _mm_and_si128(capped, cap));
+        waited = _mm_andnot_si128(early, waited);
+        __m128i waitPoints = _mm_srli_epi32(_mm_madd_epi16(_mm_srli_epi32(waited, 3), _mm_set1_epi32(DIVIDE_BY_75)), 21);
+        
+        __m128i score = _mm_sub_epi32(_mm_sub_epi32(_mm_set1_epi32(100), penalty), waitPoints);
+        score = _mm_and_si128(score, _mm_cmpgt_epi32(score, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), score);
+    }
+    scoreScalar(batch, i, count, now, out);
+}
+
+// Puts 32-bit lane 0 of each 64-bit element of a, then of b, in order
+__attribute__((target("avx2")))
+static inline __m256i packEvenLanes(__m256 a, __m256 b) {
+    __m256 mixed = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));    // 0 1 4 5 | 2 3 6 7
+    return _mm256_permute4x64_epi64(_mm256_castps_si256(mixed), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i packOddLanes(__m256 a, __m256 b) {
+    __m256 mixed = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_permute4x64_epi64(_mm256_castps_si256(mixed), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i lessThan(__m256i values, int32_t limit) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(limit), values);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i greaterThan(__m256i values, int32_t limit) {
+    return _mm256_cmpgt_epi32(values, _mm256_set1_epi32(limit));
+}
+
+__attribute__((target("avx2")))
+static void scoreAvx2(const ScoringBatch& batch, size_t count, int64_t now, int32_t* out) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i fifteen = _mm256_set1_epi32(15);
+    const __m256i nowWide = _mm256_set1_epi64x(now);
+    const __m256i cap = _mm256_set1_epi32(WAIT_CAP);
+    const __m256d feverAbove = _mm256_set1_pd(39.0);
+    const __m256d chillBelow = _mm256_set1_pd(35.0);
+    
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i heart = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.heartRate + i));
+        __m256i pressure = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.bloodPressure + i));
+        __m256i oxygen = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.oxygenLevel + i));
+        
+        __m256i heartSevere = _mm256_or_si256(lessThan(heart, 50), greaterThan(heart, 120));
+        __m256i heartMild = _mm256_or_si256(lessThan(heart, 60), greaterThan(heart, 100));
+        __m256i pressureSevere = _mm256_or_si256(lessThan(pressure, 90), greaterThan(pressure, 160));
+        __m256i pressureMild = _mm256_or_si256(lessThan(pressure, 100), greaterThan(pressure, 140));
+        __m256i oxygenSevere = lessThan(oxygen, 90);
+        __m256i oxygenMild = lessThan(oxygen, 95);
+        
+        __m256d low = _mm256_loadu_pd(batch.temperature + i);
+        __m256d high = _mm256_loadu_pd(batch.temperature + i + 4);
+        __m256d lowOut = _mm256_or_pd(_mm256_cmp_pd(low, feverAbove, _CMP_GT_OQ),
+                                      _mm256_cmp_pd(low, chillBelow, _CMP_LT_OQ));
+        __m256d highOut = _mm256_or_pd(_mm256_cmp_pd(high, feverAbove, _CMP_GT_OQ),
+                                       _mm256_cmp_pd(high, chillBelow, _CMP_LT_OQ));
+        __m256i temperatureOut = packEvenLanes(_mm256_castpd_ps(lowOut), _mm256_castpd_ps(highOut));
+        
+        __m256i penalty = _mm256_add_epi32(_mm256_and_si256(heartSevere, fifteen), _mm256_and_si256(heartMild, fifteen));
+        penalty = _mm256_add_epi32(penalty, _mm256_and_si256(pressureSevere, fifteen));
+        penalty = _mm256_add_epi32(penalty, _mm256_and_si256(pressureMild, _mm256_set1_epi32(10)));
+        penalty = _mm256_add_epi32(penalty, _mm256_and_si256(oxygenSevere, fifteen));
+        penalty = _mm256_add_epi32(penalty, _mm256_and_si256(oxygenMild, _mm256_set1_epi32(20)));
+        penalty = _mm256_add_epi32(penalty, _mm256_and_si256(temperatureOut, fifteen));
+        
+        __m256i waitedA = _mm256_sub_epi64(nowWide, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.arrivalTime + i)));
+        __m256i waitedB = _mm256_sub_epi64(nowWide, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.arrivalTime + i + 4)));
+        __m256i waitLow = packEvenLanes(_mm256_castsi256_ps(waitedA), _mm256_castsi256_ps(waitedB));
+        __m256i waitHigh = packOddLanes(_mm256_castsi256_ps(waitedA), _mm256_castsi256_ps(waitedB));
+        __m256i early = _mm256_cmpgt_epi32(zero, waitHigh);
+        __m256i capped = _mm256_or_si256(_mm256_cmpgt_epi32(waitHigh, zero),
+                                         _mm256_or_si256(_mm256_cmpgt_epi32(zero, waitLow), _mm256_cmpgt_epi32(waitLow, cap)));
+        __m256i waited = _mm256_blendv_epi8(waitLow, cap, capped);
+        waited = _mm256_andnot_si256(early, waited);
+        __m256i waitPoints = _mm256_srli_epi32(_mm256_madd_epi16(_mm256_srli_epi32(waited, 3),
+                                                                 _mm256_set1_epi32(DIVIDE_BY_75)), 21);
+        
+        __m256i score = _mm256_sub_epi32(_mm256_sub_epi32(_mm256_set1_epi32(100), penalty), waitPoints);
+        score = _mm256_max_epi32(score, zero);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), score);
+    }
+    scoreScalar(batch, i, count, now, out);
+}
+#endif
+
+bool PatientColumns::isSupported(ScoringPath path) {
+    switch (path) {
+        case ScoringPath::SCALAR:
+            return true;
+#ifdef PATIENT_COLUMNS_X86
+        case ScoringPath::SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case ScoringPath::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+ScoringPath PatientColumns::bestPath() {
+    static const ScoringPath best = isSupported(ScoringPath::AVX2) ? ScoringPath::AVX2
+                                  : isSupported(ScoringPath::SSE2) ? ScoringPath::SSE2
+                                  : ScoringPath::SCALAR;
+    return best;
+}
+
+const char* PatientColumns::pathName(ScoringPath path) {
+    switch (path) {
+        case ScoringPath::SSE2: return "SSE2";
+        case ScoringPath::AVX2: return "AVX2";
+        case ScoringPath::SCALAR:
+        default: return "scalar";
+    }
+}
+
+void PatientColumns::scoreRange(size_t first, size_t count, time_t now, int32_t* out) const {
+    scoreRange(first, count, now, out, bestPath());
+}
+
+void PatientColumns::scoreRange(size_t first, size_t count, time_t now, int32_t* out,
+                                ScoringPath path) const {
+    if (first > size() || count > size() - first) {
+        throw std::runtime_error("Scoring range is past the end of the patient columns!");
+    }
+    if (!isSupported(path)) {
+        throw std::runtime_error(std::string(pathName(path)) + " scoring is not supported on this CPU!");
+    }
+    
+    ScoringBatch batch;
+    batch.heartRate = heartRate.data() + first;
+    batch.bloodPressure = bloodPressure.data() + first;
+    batch.oxygenLevel = oxygenLevel.data() + first;
+    batch.temperature = temperature.data() + first;
+    batch.arrivalTime = arrivalTime.data() + first;
+    int64_t nowWide = static_cast<int64_t>(now);
+    
+    switch (path) {
+#ifdef PATIENT_COLUMNS_X86
+        case ScoringPath::AVX2:
+            scoreAvx2(batch, count, nowWide, out);
+            break;
+        case ScoringPath::SSE2:
+            scoreSse2(batch, count, nowWide, out);
+            break;
+#endif
+        default:
+            scoreScalar(batch, 0, count, nowWide, out);
+            break;
+    }
+}
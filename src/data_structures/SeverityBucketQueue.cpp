@@ -0,0 +1,147 @@
+#include "../../include/data_structures/SeverityBucketQueue.hpp"
+#include <stdexcept>
+
+const int SeverityBucketQueue::MAX_SEVERITY;
+const int SeverityBucketQueue::BUCKET_COUNT;
+const uint32_t SeverityBucketQueue::NONE;
+
+static inline int countTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int zeros = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        zeros++;
+    }
+    return zeros;
+#endif
+}
+
+SeverityBucketQueue::SeverityBucketQueue() : count(0) {
+    clear();
+}
+
+void SeverityBucketQueue::checkSeverity(int severity) {
+    if (severity < 0 || severity > MAX_SEVERITY) {
+        throw std::out_of_range("Severity must be between 0 and 100!");
+    }
+}
+
+int SeverityBucketQueue::firstBucketFrom(int severity) const {
+    if (severity >= BUCKET_COUNT) return -1;
+    
+    int word = severity / WORD_BITS;
+    uint64_t bits = occupied[word] & (~0ULL << (severity % WORD_BITS));
+    while (bits == 0) {
+        if (++word == WORD_COUNT) return -1;
+        bits = occupied[word];
+    }
+    return word * WORD_BITS + countTrailingZeros(bits);
+}
+
+void SeverityBucketQueue::link(uint32_t slot, int severity) {
+    Bucket& bucket = buckets[severity];
+    next[slot] = NONE;
+    prev[slot] = bucket.tail;
+    if (bucket.tail == NONE) {
+        bucket.head = slot;
+        occupied[severity / WORD_BITS] |= 1ULL << (severity % WORD_BITS);
+    } else {
+        next[bucket.tail] = slot;
+    }
+    bucket.tail = slot;
+    slotSeverity[slot] = static_cast<int8_t>(severity);
+}
+
+void SeverityBucketQueue::unlink(uint32_t slot) {
+    int severity = slotSeverity[slot];
+    Bucket& bucket = buckets[severity];
+    
+    if (prev[slot] == NONE) bucket.head = next[slot];
+    else next[prev[slot]] = next[slot];
+    if (next[slot] == NONE) bucket.tail = prev[slot];
+    else prev[next[slot]] = prev[slot];
+    
+    if (bucket.head == NONE) {
+        occupied[severity / WORD_BITS] &= ~(1ULL << (severity % WORD_BITS));
+    }
+    slotSeverity[slot] = -1;
+}
+
+void SeverityBucketQueue::insert(uint32_t slot, int severity) {
+    checkSeverity(severity);
+    if (slot >= slotSeverity.size()) {
+        next.resize(slot + 1, NONE);
+        prev.resize(slot + 1, NONE);
+        slotSeverity.resize(slot + 1, -1);
+    }
+    if (slotSeverity[slot] >= 0) {
+        throw std::invalid_argument("Slot is already queued!");
+    }
+    
+    link(slot, severity);
+    count++;
+}
+
+uint32_t SeverityBucketQueue::extractMin() {
+    uint32_t slot = getMin();
+    unlink(slot);
+    count--;
+    return slot;
+}
+
+uint32_t SeverityBucketQueue::getMin() const {
+    int severity = firstBucketFrom(0);
+    if (severity < 0) {
+        throw std::runtime_error("Queue is empty!");
+    }
+    return buckets[severity].head;
+}
+
+void SeverityBucketQueue::update(uint32_t slot, int severity) {
+    checkSeverity(severity);
+    if (!contains(slot)) {
+        throw std::out_of_range("Slot is not queued!");
+    }
+    if (slotSeverity[slot] == severity) return;
+    
+    unlink(slot);
+    link(slot, severity);
+}
+
+void SeverityBucketQueue::erase(uint32_t slot) {
+    if (!contains(slot)) {
+        throw std::out_of_range("Slot is not queued!");
+    }
+    unlink(slot);
+    count--;
+}
+
+int SeverityBucketQueue::severityOf(uint32_t slot) const {
+    if (!contains(slot)) {
+        throw std::out_of_range("Slot is not queued!");
+    }
+    return slotSeverity[slot];
+}
+
+uint32_t SeverityBucketQueue::successor(uint32_t slot) const {
+    if (next[slot] != NONE) return next[slot];
+    
+    int severity = firstBucketFrom(slotSeverity[slot] + 1);
+    return severity < 0 ? NONE : buckets[severity].head;
+}
+
+void SeverityBucketQueue::clear() {
+    for (int b = 0; b < BUCKET_COUNT; b++) {
+        buckets[b].head = NONE;
+        buckets[b].tail = NONE;
+    }
+    for (int w = 0; w < WORD_COUNT; w++) {
+        occupied[w] = 0;
+    }
+    next.clear();
+    prev.clear();
+    slotSeverity.clear();
+    count = 0;
+}
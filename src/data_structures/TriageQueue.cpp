@@ -3,77 +3,459 @@
 #include <algorithm>
 #include <iomanip>  // ADD THIS LINE
 
-TriageQueue::TriageQueue() : totalPatientsProcessed(0) {}
+TriageQueue::TriageQueue(TriageBackend queueBackend)
+    : backend(queueBackend), nextArrival(0), totalPatientsProcessed(0), verbose(true),
+      agingEnabled(false), agingEpoch(0) {}
+
+void TriageQueue::setAgingEnabled(bool enabled) {
+    if (enabled == agingEnabled) return;
+    if (!isEmpty()) {
+        throw std::runtime_error("Aging can only be switched on an empty triage queue!");
+    }
+    if (enabled && backend == TriageBackend::SEVERITY_BUCKETS) {
+        // Aging keys span far more than the 101 severity buckets
+        throw std::runtime_error("Aging requires a heap triage backend!");
+    }
+    agingEnabled = enabled;
+    agingEpoch = std::time(nullptr);
+}
+
+int TriageQueue::priorityOf(const Patient& patient) const {
+    if (!agingEnabled) {
+        return patient.getSeverityScore();
+    }
+    // Relative to the epoch, so the key fits in 32 bits for decades
+    long long waitedFrom = static_cast<long long>(patient.getArrivalTime() - agingEpoch);
+    return static_cast<int>(static_cast<long long>(patient.calculateBaseSeverity()) 
+                            * Patient::SECONDS_PER_SEVERITY_POINT + waitedFrom);
+}
+
+Patient TriageQueue::currentView(uint32_t slot) const {
+    Patient patient = patientStore[slot];
+    if (agingEnabled) {
+        patient.updateSeverity();
+    }
+    return patient;
+}
+
+uint32_t TriageQueue::storePatient(const Patient& patient) {
+    uint32_t slot;
+    if (!freeSlots.empty()) {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        patientStore[slot] = patient;
+    } else {
+        slot = static_cast<uint32_t>(patientStore.size());
+        patientStore.push_back(patient);
+        if (usesHandles()) {
+            slotHandle.push_back(RecordHeap::INVALID_HANDLE);
+        }
+    }
+    slotIndex[patient.getPatientID()] = slot;
+    return slot;
+}
+
+Patient TriageQueue::releasePatient(uint32_t slot) {
+    Patient patient = std::move(patientStore[slot]);
+    slotIndex.erase(patient.getPatientID());
+    if (usesHandles()) {
+        slotHandle[slot] = RecordHeap::INVALID_HANDLE;
+    }
+    freeSlots.push_back(slot);
+    return patient;
+}
+
+void TriageQueue::enqueueSlot(uint32_t slot, int priority) {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            severityBuckets.insert(slot, priority);
+            break;
+        case TriageBackend::PAIRING_HEAP:
+            slotHandle[slot] = pairingHeap.insert(TriageRecord(priority, nextArrival++, slot));
+            break;
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            slotHandle[slot] = recordHeap.insert(TriageRecord(priority, nextArrival++, slot));
+            break;
+    }
+}
+
+void TriageQueue::rekeySlot(uint32_t slot, int priority) {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            severityBuckets.update(slot, priority);
+            break;
+        case TriageBackend::PAIRING_HEAP: {
+            TriageRecord record = pairingHeap.get(slotHandle[slot]);
+            if (record.priority == priority) break;
+            record.priority = priority;
+            record.arrivalSeq = nextArrival++;
+            pairingHeap.update(slotHandle[slot], record);
+            break;
+        }
+        case TriageBackend::INDEXED_HEAP:
+        default: {
+            // A new severity counts as a fresh arrival at that level, matching
+            // the bucket backend; an unchanged one keeps its place
+            TriageRecord record = recordHeap.get(slotHandle[slot]);
+            if (record.priority == priority) break;
+            record.priority = priority;
+            record.arrivalSeq = nextArrival++;
+            recordHeap.update(slotHandle[slot], record);
+            break;
+        }
+    }
+}
+
+void TriageQueue::dropSlot(uint32_t slot) {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            severityBuckets.erase(slot);
+            break;
+        case TriageBackend::PAIRING_HEAP:
+            pairingHeap.erase(slotHandle[slot]);
+            break;
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            recordHeap.erase(slotHandle[slot]);
+            break;
+    }
+}
+
+uint32_t TriageQueue::dequeueSlot() {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            return severityBuckets.extractMin();
+        case TriageBackend::PAIRING_HEAP:
+            return pairingHeap.extractMin().patientIndex;
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            return recordHeap.extractMin().patientIndex;
+    }
+}
+
+uint32_t TriageQueue::frontSlot() const {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            return severityBuckets.getMin();
+        case TriageBackend::PAIRING_HEAP:
+            return pairingHeap.getMin().patientIndex;
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            return recordHeap.getMin().patientIndex;
+    }
+}
+
+int TriageQueue::getPendingCount() const {
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS:
+            return severityBuckets.size();
+        case TriageBackend::PAIRING_HEAP:
+            return pairingHeap.size();
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            return recordHeap.size();
+    }
+}
 
 void TriageQueue::addPatient(const Patient& patient) {
-    patientHeap.insert(patient);
-    std::cout << "✓ Patient " << patient.getPatientID() 
-              << " added to triage queue (Severity: " 
-              << patient.getSeverityScore() << ")\n";
+    // A patient is queued at most once; re-adding just refreshes the entry
+    // (keeping their place among equal-severity patients)
+    auto it = slotIndex.find(patient.getPatientID());
+    if (it != slotIndex.end()) {
+        uint32_t slot = it->second;
+        patientStore[slot] = patient;
+        rekeySlot(slot, priorityOf(patient));
+    } else {
+        uint32_t slot = storePatient(patient);
+        enqueueSlot(slot, priorityOf(patient));
+    }
+    
+    if (verbose) {
+        std::cout << "✓ Patient " << patient.getPatientID() 
+                  << " added to triage queue (Severity: " 
+                  << patient.getSeverityScore() << ")\n";
+    }
+}
+
+void TriageQueue::addPatientsBatch(const std::vector<Patient>& patients) {
+    slotIndex.reserve(slotIndex.size() + patients.size());
+    patientStore.reserve(patientStore.size() + patients.size());
+    
+    std::vector<TriageRecord> pending;
+    for (const Patient& patient : patients) {
+        int priority = priorityOf(patient);
+        auto it = slotIndex.find(patient.getPatientID());
+        if (it == slotIndex.end()) {
+            uint32_t slot = storePatient(patient);
+            if (backend == TriageBackend::INDEXED_HEAP) {
+                pending.push_back(TriageRecord(priority, nextArrival++, slot));
+            } else {
+                enqueueSlot(slot, priority);    // already O(1) per patient
+            }
+            continue;
+        }
+        
+        // Already queued: refresh it exactly as addPatient would
+        uint32_t slot = it->second;
+        patientStore[slot] = patient;
+        if (backend != TriageBackend::INDEXED_HEAP || 
+            slotHandle[slot] != RecordHeap::INVALID_HANDLE) {
+            rekeySlot(slot, priority);
+            continue;
+        }
+        
+        // Repeated within this batch, so its record is not in the heap yet.
+        // Rare enough that a scan of the pending records is fine.
+        for (TriageRecord& record : pending) {
+            if (record.patientIndex == slot && record.priority != priority) {
+                record.priority = priority;
+                record.arrivalSeq = nextArrival++;
+            }
+        }
+    }
+    
+    if (!pending.empty()) {
+        std::vector<RecordHeap::Handle> handles;
+        recordHeap.insertBatch(pending, handles);
+        for (size_t i = 0; i < pending.size(); i++) {
+            slotHandle[pending[i].patientIndex] = handles[i];
+        }
+    }
+    
+    if (verbose) {
+        std::cout << "✓ " << patients.size() << " patients added to triage queue\n";
+    }
+}
+
+std::vector<TriageRecord> TriageQueue::collectRecords() const {
+    std::vector<TriageRecord> records;
+    records.reserve(getPendingCount());
+    switch (backend) {
+        case TriageBackend::SEVERITY_BUCKETS: {
+            // Buckets carry no sequence numbers; service order stands in for them
+            uint32_t sequence = 0;
+            uint32_t slot = isEmpty() ? SeverityBucketQueue::NONE : severityBuckets.getMin();
+            for (; slot != SeverityBucketQueue::NONE; slot = severityBuckets.successor(slot)) {
+                records.push_back(TriageRecord(severityBuckets.severityOf(slot), sequence++, slot));
+            }
+            break;
+        }
+        case TriageBackend::PAIRING_HEAP:
+            pairingHeap.forEachItem([&records](const TriageRecord& record) {
+                records.push_back(record);
+            });
+            break;
+        case TriageBackend::INDEXED_HEAP:
+        default:
+            for (int i = 0; i < recordHeap.size(); i++) {
+                records.push_back(recordHeap.itemAt(i));
+            }
+            break;
+    }
+    return records;
+}
+
+void TriageQueue::resetQueue() {
+    recordHeap.clear();
+    severityBuckets.clear();
+    pairingHeap.clear();
+    patientStore.clear();
+    slotHandle.clear();
+    freeSlots.clear();
+    slotIndex.clear();
+    nextArrival = 0;
+}
+
+void TriageQueue::mergeFrom(TriageQueue&& other) {
+    if (&other == this || other.isEmpty()) return;
+    if (other.agingEnabled != agingEnabled) {
+        throw std::runtime_error("Cannot merge triage queues with different aging settings!");
+    }
+    
+    // 1. Move the patients into our store. Anyone already queued here is
+    //    refreshed in place and dropped from other before its heap moves.
+    const uint32_t NOT_MOVED = 0xFFFFFFFFu;
+    std::vector<uint32_t> slotMap(other.patientStore.size(), NOT_MOVED);
+    for (const auto& entry : other.slotIndex) {
+        uint32_t otherSlot = entry.second;
+        auto it = slotIndex.find(entry.first);
+        if (it != slotIndex.end()) {
+            patientStore[it->second] = std::move(other.patientStore[otherSlot]);
+            rekeySlot(it->second, priorityOf(patientStore[it->second]));
+            other.dropSlot(otherSlot);
+        } else {
+            slotMap[otherSlot] = storePatient(other.patientStore[otherSlot]);
+        }
+    }
+    
+    // 2. Bring other's records into our frame. Every shift is uniform, so
+    //    other's internal order (and heap shape) is unaffected.
+    int keyShift = agingEnabled ? static_cast<int>(other.agingEpoch - agingEpoch) : 0;
+    uint32_t arrivalShift = nextArrival;
+    auto remap = [&slotMap, keyShift, arrivalShift](TriageRecord& record) {
+        record.patientIndex = slotMap[record.patientIndex];
+        record.priority += keyShift;
+        record.arrivalSeq += arrivalShift;
+    };
+    uint32_t moved = static_cast<uint32_t>(other.getPendingCount());
+    nextArrival += std::max(other.nextArrival, moved);
+    
+    if (backend == TriageBackend::PAIRING_HEAP && other.backend == TriageBackend::PAIRING_HEAP) {
+        // 3a. Pool copy plus one root link; handles shift by a constant
+        other.pairingHeap.rewriteItems(remap);
+        uint32_t offset = pairingHeap.meld(std::move(other.pairingHeap));
+        for (size_t otherSlot = 0; otherSlot < slotMap.size(); otherSlot++) {
+            if (slotMap[otherSlot] != NOT_MOVED) {
+                slotHandle[slotMap[otherSlot]] = other.slotHandle[otherSlot] + offset;
+            }
+        }
+    } else {
+        // 3b. Different layouts: re-insert other's records
+        std::vector<TriageRecord> records = other.collectRecords();
+        for (TriageRecord& record : records) {
+            remap(record);
+        }
+        switch (backend) {
+            case TriageBackend::SEVERITY_BUCKETS:
+                // Buckets are FIFO by insertion, so feed them in service order
+                std::sort(records.begin(), records.end());
+                for (const TriageRecord& record : records) {
+                    severityBuckets.insert(record.patientIndex, record.priority);
+                }
+                break;
+            case TriageBackend::PAIRING_HEAP:
+                for (const TriageRecord& record : records) {
+                    slotHandle[record.patientIndex] = pairingHeap.insert(record);
+                }
+                break;
+            case TriageBackend::INDEXED_HEAP:
+            default: {
+                std::vector<RecordHeap::Handle> handles;
+                recordHeap.insertBatch(records, handles);
+                for (size_t i = 0; i < records.size(); i++) {
+                    slotHandle[records[i].patientIndex] = handles[i];
+                }
+                break;
+            }
+        }
+    }
+    
+    other.resetQueue();
+    
+    if (verbose) {
+        std::cout << "✓ Merged " << moved << " waiting patients into triage queue\n";
+    }
 }
 
 Patient TriageQueue::getNextPatient() {
-    if (patientHeap.isEmpty()) {
+    if (isEmpty()) {
         throw std::runtime_error("No patients in queue!");
     }
     
-    Patient nextPatient = patientHeap.extractMin();
+    // Only slots move through the queue; the Patient itself is moved out of
+    // its store slot exactly once, here
+    Patient nextPatient = releasePatient(dequeueSlot());
+    if (agingEnabled) {
+        nextPatient.updateSeverity();
+    }
     totalPatientsProcessed++;
     
-    std::cout << "→ Next patient: " << nextPatient.getPatientID() 
-              << " (Severity: " << nextPatient.getSeverityScore() << ")\n";
+    if (verbose) {
+        std::cout << "→ Next patient: " << nextPatient.getPatientID() 
+                  << " (Severity: " << nextPatient.getSeverityScore() << ")\n";
+    }
     
     return nextPatient;
 }
 
 Patient TriageQueue::peekNextPatient() const {
-    return patientHeap.getMin();
+    return currentView(frontSlot());
 }
 
-void TriageQueue::updatePatientPriority(const std::string& patientID, const VitalSigns& newVitals) {
-    // For simplicity, we rebuild the heap after update
-    // In production, this would use a decrease-key operation
-    std::vector<Patient> tempPatients;
+void TriageQueue::updatePatientPriority(const PatientId& patientID, const VitalSigns& newVitals) {
+    auto it = slotIndex.find(patientID);
+    if (it == slotIndex.end()) {
+        std::cout << "✗ Patient " << patientID << " is not in the triage queue\n";
+        return;
+    }
     
-    while (!patientHeap.isEmpty()) {
-        Patient p = patientHeap.extractMin();
-        if (p.getPatientID() == patientID) {
-            p.setVitalSigns(newVitals);
-            p.updateSeverity();
-            std::cout << "✓ Updated priority for patient " << patientID << "\n";
-        }
-        tempPatients.push_back(p);
+    // Re-key in place: one sift, or one bucket relink
+    uint32_t slot = it->second;
+    patientStore[slot].setVitalSigns(newVitals);
+    rekeySlot(slot, priorityOf(patientStore[slot]));
+    
+    if (verbose) {
+        std::cout << "✓ Updated priority for patient " << patientID << "\n";
+    }
+}
+
+bool TriageQueue::removePatient(const PatientId& patientID) {
+    auto it = slotIndex.find(patientID);
+    if (it == slotIndex.end()) {
+        return false;
     }
     
-    patientHeap.buildHeap(tempPatients);
+    uint32_t slot = it->second;
+    dropSlot(slot);
+    releasePatient(slot);
+    return true;
 }
 
-std::vector<Patient> TriageQueue::getCriticalPatients(int count) {
+bool TriageQueue::removeTreatedPatient(const PatientId& patientID) {
+    if (!removePatient(patientID)) {
+        return false;
+    }
+    totalPatientsProcessed++;
+    return true;
+}
+
+bool TriageQueue::contains(const PatientId& patientID) const {
+    return slotIndex.find(patientID) != slotIndex.end();
+}
+
+std::vector<Patient> TriageQueue::getCriticalPatients(int count) const {
     std::vector<Patient> criticalPatients;
-    std::vector<Patient> tempStorage;
+    if (count <= 0) return criticalPatients;
     
-    int retrieved = 0;
-    while (!patientHeap.isEmpty() && retrieved < count) {
-        Patient p = patientHeap.extractMin();
-        criticalPatients.push_back(p);
-        tempStorage.push_back(p);
-        retrieved++;
+    if (backend == TriageBackend::SEVERITY_BUCKETS) {
+        // Buckets are already in service order - just walk them
+        uint32_t slot = isEmpty() ? SeverityBucketQueue::NONE : severityBuckets.getMin();
+        for (int i = 0; i < count && slot != SeverityBucketQueue::NONE; i++) {
+            criticalPatients.push_back(currentView(slot));
+            slot = severityBuckets.successor(slot);
+        }
+        return criticalPatients;
     }
     
-    // Restore heap
-    while (!patientHeap.isEmpty()) {
-        tempStorage.push_back(patientHeap.extractMin());
+    // Best-first walk of the heap; the heap itself is left alone
+    std::vector<TriageRecord> top = (backend == TriageBackend::PAIRING_HEAP)
+        ? pairingHeap.peekSmallest(count) : recordHeap.peekSmallest(count);
+    criticalPatients.reserve(top.size());
+    for (const TriageRecord& record : top) {
+        criticalPatients.push_back(currentView(record.patientIndex));
     }
-    patientHeap.buildHeap(tempStorage);
-    
     return criticalPatients;
 }
 
-void TriageQueue::displayQueue() const {
+void TriageQueue::displayQueue(int topCount) const {
     std::cout << "\n╔════════════════════════════════════════════════╗\n";
     std::cout << "║         TRIAGE QUEUE STATUS                    ║\n";
     std::cout << "╠════════════════════════════════════════════════╣\n";
     std::cout << "║ Pending Patients: " << std::setw(28) << getPendingCount() << " ║\n";
     std::cout << "║ Total Processed: " << std::setw(29) << totalPatientsProcessed << " ║\n";
+    
+    // Polled by status screens, so this must stay read-only and cheap
+    std::vector<Patient> next = getCriticalPatients(topCount);
+    if (!next.empty()) {
+        std::cout << "╠════════════════════════════════════════════════╣\n";
+        std::cout << "║ Next    Patient ID              Severity       ║\n";
+        for (size_t i = 0; i < next.size(); i++) {
+            std::cout << "║ " << std::setw(4) << i + 1 << "    " 
+                      << std::setw(24) << std::left << next[i].getPatientID().str().substr(0, 23) 
+                      << std::right << std::setw(8) << next[i].getSeverityScore() 
+                      << "       ║\n";
+        }
+    }
     std::cout << "╚════════════════════════════════════════════════╝\n";
 }
\ No newline at end of file
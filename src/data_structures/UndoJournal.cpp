@@ -0,0 +1,494 @@
+#include "../../include/data_structures/UndoJournal.hpp"
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+const uint8_t UndoEntry::SPILLED;
+const uint32_t UndoJournal::NO_SYMBOL;
+
+// A batch spill opens with the replaced registrations' count and position
+static const uint32_t BATCH_HEADER = 2;
+
+// Indexed by OperationType
+static const char* const OPERATION_NAMES[] = {
+    "Patient Registered",
+    "Patient Treated",
+    "Patient Transferred",
+    "Patient Discharged",
+    "Staff Assigned",
+    "Equipment Allocated",
+    "Patients Batch Registered",
+    "Vitals Updated"
+};
+
+static const char* const DESCRIPTIONS[] = {
+    "New patient registered",
+    "Patient taken into treatment",
+    "Patient moved to a new location",
+    "Patient discharged",
+    "Staff member assigned to patient",
+    "Equipment allocated",
+    "Batch admission",
+    "Vital signs updated"
+};
+
+static const size_t OPERATION_COUNT = sizeof(OPERATION_NAMES) / sizeof(OPERATION_NAMES[0]);
+
+static bool fitsInt16(long long value) {
+    return value >= -32768 && value <= 32767;
+}
+
+// Temperatures are recorded to two decimals; rounding makes the round trip exact
+static double restoreTemperature(double current, int centi) {
+    return std::round((current - centi / 100.0) * 100.0) / 100.0;
+}
+
+template<typename T>
+void UndoJournal::SideStore<T>::truncate(uint32_t position) {
+    items.resize(position - base);
+    if (released > items.size()) released = items.size();
+}
+
+template<typename T>
+void UndoJournal::SideStore<T>::releaseBefore(uint32_t position) {
+    released = position - base;
+    // Compact once at least half the items are dead: amortized O(1)
+    if (released * 2 >= items.size()) {
+        items.erase(items.begin(), items.begin() + released);
+        base = position;
+        released = 0;
+    }
+}
+
+UndoJournal::UndoJournal(size_t capacity) : entries(capacity) {}
+
+uint32_t UndoJournal::intern(const Symbol& name) {
+    auto it = symbolIndex.find(name);
+    if (it != symbolIndex.end()) {
+        symbolRefs[it->second]++;
+        return it->second;
+    }
+    
+    uint32_t id;
+    if (!freeSymbols.empty()) {
+        id = freeSymbols.back();
+        freeSymbols.pop_back();
+        symbols[id] = name;
+        symbolRefs[id] = 1;
+    } else {
+        id = static_cast<uint32_t>(symbols.size());
+        symbols.push_back(name);
+        symbolRefs.push_back(1);
+    }
+    symbolIndex[name] = id;
+    return id;
+}
+
+void UndoJournal::releaseSymbol(uint32_t id) {
+    if (id == NO_SYMBOL) return;
+    if (--symbolRefs[id] == 0) {
+        symbolIndex.erase(symbols[id]);
+        freeSymbols.push_back(id);
+    }
+}
+
+void UndoJournal::releaseSymbols(const UndoEntry& entry) {
+    switch (entry.operation) {
+        case OperationType::PATIENTS_BATCH_REGISTERED: {
+            uint32_t end = entry.payload.spill.first + entry.payload.spill.count;
+            for (uint32_t i = entry.payload.spill.first + BATCH_HEADER; i < end; i++) {
+                releaseSymbol(spilledSymbols.at(i));
+            }
+            break;
+        }
+        case OperationType::PATIENT_TRANSFERRED:
+            releaseSymbol(entry.payload.move.from);
+            releaseSymbol(entry.payload.move.to);
+            break;
+        case OperationType::STAFF_ASSIGNED:
+            releaseSymbol(entry.payload.staff.staff);
+            releaseSymbol(entry.payload.staff.previousPatient);
+            break;
+        default:
+            break;
+    }
+    releaseSymbol(entry.subject);
+}
+
+UndoEntry UndoJournal::makeEntry(OperationType operation, uint32_t subject) {
+    UndoEntry entry;
+    std::memset(&entry, 0, sizeof(entry));
+    entry.operation = operation;
+    entry.subject = subject;
+    return entry;
+}
+
+void UndoJournal::push(const UndoEntry& entry) {
+    if (entries.isFull()) {
+        releaseSymbols(entries.peekOldest());
+        releaseSpill(entries.peekOldest(), true);
+    }
+    entries.push(entry);
+}
+
+void UndoJournal::releaseSpill(const UndoEntry& entry, bool evicted) {
+    if (!(entry.flags & UndoEntry::SPILLED)) return;
+    
+    uint32_t first = entry.payload.spill.first;
+    uint32_t end = first + entry.payload.spill.count;
+    switch (entry.operation) {
+        case OperationType::PATIENTS_BATCH_REGISTERED: {
+            uint32_t replacedFirst = spilledSymbols.at(first + 1);
+            uint32_t replacedEnd = replacedFirst + spilledSymbols.at(first);
+            if (evicted) {
+                spilledSymbols.releaseBefore(end);
+                spilledPatients.releaseBefore(replacedEnd);
+            } else {
+                spilledSymbols.truncate(first);
+                spilledPatients.truncate(replacedFirst);
+            }
+            break;
+        }
+        case OperationType::VITALS_UPDATED:
+            if (evicted) spilledVitals.releaseBefore(end);
+            else spilledVitals.truncate(first);
+            break;
+        case OperationType::PATIENT_REGISTERED:
+            if (evicted) spilledPatients.releaseBefore(end);
+            else spilledPatients.truncate(first);
+            break;
+        default:
+            break;
+    }
+}
+
+void UndoJournal::recordRegistration(const PatientId& patientID, const Patient* replaced,
+                                     bool replacedWasQueued) {
+    UndoEntry entry = makeEntry(OperationType::PATIENT_REGISTERED, intern(Symbol(patientID)));
+    if (replaced) {
+        entry.flags = UndoEntry::SPILLED;
+        entry.payload.spill.first = spilledPatients.end();
+        entry.payload.spill.count = 1;
+        spilledPatients.items.push_back(ReplacedRegistration(*replaced, replacedWasQueued));
+    }
+    push(entry);
+}
+
+void UndoJournal::recordBatchRegistration(const std::vector<PatientId>& newPatientIDs,
+                                          const std::vector<ReplacedRegistration>& replaced) {
+    UndoEntry entry = makeEntry(OperationType::PATIENTS_BATCH_REGISTERED, NO_SYMBOL);
+    entry.flags = UndoEntry::SPILLED;
+    entry.payload.spill.first = spilledSymbols.end();
+    entry.payload.spill.count = static_cast<uint32_t>(newPatientIDs.size()) + BATCH_HEADER;
+    spilledSymbols.items.push_back(static_cast<uint32_t>(replaced.size()));
+    spilledSymbols.items.push_back(spilledPatients.end());
+    for (const PatientId& id : newPatientIDs) {
+        spilledSymbols.items.push_back(intern(Symbol(id)));
+    }
+    spilledPatients.items.insert(spilledPatients.items.end(), replaced.begin(), replaced.end());
+    push(entry);
+}
+
+void UndoJournal::recordStatusChange(OperationType operation, const PatientId& patientID,
+                                     TriageStatus before, TriageStatus after) {
+    UndoEntry entry = makeEntry(operation, intern(Symbol(patientID)));
+    entry.statusBefore = static_cast<uint8_t>(before);
+    entry.statusAfter = static_cast<uint8_t>(after);
+    push(entry);
+}
+
+void UndoJournal::recordVitalsChange(const PatientId& patientID, const VitalSigns& before,
+                                     const VitalSigns& after) {
+    UndoEntry entry = makeEntry(OperationType::VITALS_UPDATED, intern(Symbol(patientID)));
+    
+    long long heart = static_cast<long long>(after.heartRate) - before.heartRate;
+    long long pressure = static_cast<long long>(after.bloodPressure) - before.bloodPressure;
+    long long oxygen = static_cast<long long>(after.oxygenLevel) - before.oxygenLevel;
+    long long centi = std::llround((after.temperature - before.temperature) * 100.0);
+    
+    bool exact = fitsInt16(heart) && fitsInt16(pressure) && fitsInt16(oxygen) && fitsInt16(centi) &&
+                 restoreTemperature(after.temperature, static_cast<int>(centi)) == before.temperature;
+    if (exact) {
+        entry.payload.vitals.heartRate = static_cast<int16_t>(heart);
+        entry.payload.vitals.bloodPressure = static_cast<int16_t>(pressure);
+        entry.payload.vitals.oxygenLevel = static_cast<int16_t>(oxygen);
+        entry.payload.vitals.temperatureCenti = static_cast<int16_t>(centi);
+    } else {
+        // Out-of-range readings: keep the old vitals whole
+        entry.flags = UndoEntry::SPILLED;
+        entry.payload.spill.first = spilledVitals.end();
+        entry.payload.spill.count = 1;
+        spilledVitals.items.push_back(before);
+    }
+    push(entry);
+}
+
+void UndoJournal::recordTransfer(const PatientId& patientID, const LocationId& from,
+                                 const LocationId& to) {
+    UndoEntry entry = makeEntry(OperationType::PATIENT_TRANSFERRED, intern(Symbol(patientID)));
+    entry.payload.move.from = intern(Symbol(from));
+    entry.payload.move.to = intern(Symbol(to));
+    push(entry);
+}
+
+void UndoJournal::recordStaffAssignment(const PatientId& patientID, const MedicalStaff& staffBefore) {
+    UndoEntry entry = makeEntry(OperationType::STAFF_ASSIGNED, intern(Symbol(patientID)));
+    entry.statusBefore = static_cast<uint8_t>(staffBefore.getStatus());
+    entry.payload.staff.staff = intern(Symbol(staffBefore.getStaffID()));
+    const PatientId& previous = staffBefore.getAssignedPatientID();
+    entry.payload.staff.previousPatient = previous.empty() ? NO_SYMBOL : intern(Symbol(previous));
+    push(entry);
+}
+
+void UndoJournal::pop() {
+    releaseSymbols(entries.peek());
+    releaseSpill(entries.peek(), false);
+    entries.pop();
+}
+
+VitalSigns UndoJournal::previousVitals(const UndoEntry& entry, const VitalSigns& current) const {
+    if (entry.flags & UndoEntry::SPILLED) {
+        return spilledVitals.at(entry.payload.spill.first);
+    }
+    
+    const UndoEntry::VitalsDelta& delta = entry.payload.vitals;
+    VitalSigns vitals;
+    vitals.heartRate = current.heartRate - delta.heartRate;
+    vitals.bloodPressure = current.bloodPressure - delta.bloodPressure;
+    vitals.oxygenLevel = current.oxygenLevel - delta.oxygenLevel;
+    vitals.temperature = restoreTemperature(current.temperature, delta.temperatureCenti);
+    return vitals;
+}
+
+std::vector<PatientId> UndoJournal::batchPatientIDs(const UndoEntry& entry) const {
+    std::vector<PatientId> ids;
+    ids.reserve(entry.payload.spill.count - BATCH_HEADER);
+    for (uint32_t i = BATCH_HEADER; i < entry.payload.spill.count; i++) {
+        ids.push_back(PatientId(symbols[spilledSymbols.at(entry.payload.spill.first + i)]));
+    }
+    return ids;
+}
+
+size_t UndoJournal::replacedCount(const UndoEntry& entry) const {
+    if (!(entry.flags & UndoEntry::SPILLED)) return 0;
+    if (entry.operation == OperationType::PATIENT_REGISTERED) return 1;
+    if (entry.operation == OperationType::PATIENTS_BATCH_REGISTERED) {
+        return spilledSymbols.at(entry.payload.spill.first);
+    }
+    return 0;
+}
+
+const ReplacedRegistration& UndoJournal::replaced(const UndoEntry& entry, size_t index) const {
+    if (index >= replacedCount(entry)) {
+        throw std::runtime_error("Entry did not replace a registration!");
+    }
+    if (entry.operation == OperationType::PATIENT_REGISTERED) {
+        return spilledPatients.at(entry.payload.spill.first);
+    }
+    uint32_t first = spilledSymbols.at(entry.payload.spill.first + 1);
+    return spilledPatients.at(first + static_cast<uint32_t>(index));
+}
+
+void UndoJournal::clear() {
+    entries.clear();
+    symbols.clear();
+    symbolRefs.clear();
+    freeSymbols.clear();
+    symbolIndex.clear();
+    spilledSymbols.clear();
+    spilledVitals.clear();
+    spilledPatients.clear();
+}
+
+size_t UndoJournal::memoryUsage() const {
+    size_t bytes = entries.size() * sizeof(UndoEntry);
+    bytes += (spilledSymbols.items.size() - spilledSymbols.released) * sizeof(uint32_t);
+    bytes += (spilledVitals.items.size() - spilledVitals.released) * sizeof(VitalSigns);
+    bytes += (spilledPatients.items.size() - spilledPatients.released) * sizeof(ReplacedRegistration);
+    
+    bytes += symbolCount() * (sizeof(Symbol) + sizeof(uint32_t));
+    bytes += symbolIndex.memoryUsage();
+    return bytes;
+}
+
+// Encoding, oldest entry first:
+//   symbols   u32 count, then (symbol, u32 references); zero marks a free slot
+//   spills    for symbols, vitals and replaced registrations in turn: u32
+//             first live position, u32 count, then the items - u32 values;
+//             i32 heart rate, i32 blood pressure, i32 oxygen, double
+//             temperature; u8 was queued, patient
+//   entries   u32 count, then (u8 operation, u8 flags, u8 status before,
+//             u8 status after, u32 subject, payload) where the payload is
+//             four i32 for a vitals delta and two u32 otherwise
+void UndoJournal::encode(RecordWriter& record, PatientWriter writePatient) const {
+    record.putU32(static_cast<uint32_t>(symbols.size()));
+    for (size_t i = 0; i < symbols.size(); i++) {
+        record.putString(symbols[i]);
+        record.putU32(symbolRefs[i]);
+    }
+    
+    record.putU32(spilledSymbols.base + static_cast<uint32_t>(spilledSymbols.released));
+    record.putU32(static_cast<uint32_t>(spilledSymbols.items.size() - spilledSymbols.released));
+    for (size_t i = spilledSymbols.released; i < spilledSymbols.items.size(); i++) {
+        record.putU32(spilledSymbols.items[i]);
+    }
+    record.putU32(spilledVitals.base + static_cast<uint32_t>(spilledVitals.released));
+    record.putU32(static_cast<uint32_t>(spilledVitals.items.size() - spilledVitals.released));
+    for (size_t i = spilledVitals.released; i < spilledVitals.items.size(); i++) {
+        const VitalSigns& vitals = spilledVitals.items[i];
+        record.putI32(vitals.heartRate);
+        record.putI32(vitals.bloodPressure);
+        record.putI32(vitals.oxygenLevel);
+        record.putDouble(vitals.temperature);
+    }
+    record.putU32(spilledPatients.base + static_cast<uint32_t>(spilledPatients.released));
+    record.putU32(static_cast<uint32_t>(spilledPatients.items.size() - spilledPatients.released));
+    for (size_t i = spilledPatients.released; i < spilledPatients.items.size(); i++) {
+        record.putU8(spilledPatients.items[i].wasQueued ? 1 : 0);
+        writePatient(record, spilledPatients.items[i].patient);
+    }
+    
+    record.putU32(static_cast<uint32_t>(entries.size()));
+    for (size_t depth = 0; depth < entries.size(); depth++) {
+        const UndoEntry& entry = entries.at(depth);
+        record.putU8(static_cast<uint8_t>(entry.operation));
+        record.putU8(entry.flags);
+        record.putU8(entry.statusBefore);
+        record.putU8(entry.statusAfter);
+        record.putU32(entry.subject);
+        if (entry.operation == OperationType::VITALS_UPDATED && !(entry.flags & UndoEntry::SPILLED)) {
+            record.putI32(entry.payload.vitals.heartRate);
+            record.putI32(entry.payload.vitals.bloodPressure);
+            record.putI32(entry.payload.vitals.oxygenLevel);
+            record.putI32(entry.payload.vitals.temperatureCenti);
+        } else {
+            // Move, StaffChange and Spill share one layout: two u32
+            record.putU32(entry.payload.spill.first);
+            record.putU32(entry.payload.spill.count);
+        }
+    }
+}
+
+void UndoJournal::decode(RecordReader& record, PatientReader readPatient) {
+    clear();
+    
+    uint32_t symbolCount = record.getU32();
+    for (uint32_t i = 0; i < symbolCount; i++) {
+        Symbol name = record.getString();
+        uint32_t references = record.getU32();
+        symbols.push_back(name);
+        symbolRefs.push_back(references);
+        if (references == 0) {
+            freeSymbols.push_back(i);
+        } else if (!symbolIndex.insert(std::make_pair(name, i)).second) {
+            throw std::runtime_error("Corrupt undo history!");
+        }
+    }
+    
+    spilledSymbols.base = record.getU32();
+    spilledSymbols.items.resize(record.getU32());
+    for (uint32_t& value : spilledSymbols.items) {
+        value = record.getU32();
+    }
+    spilledVitals.base = record.getU32();
+    spilledVitals.items.resize(record.getU32());
+    for (VitalSigns& vitals : spilledVitals.items) {
+        vitals.heartRate = record.getI32();
+        vitals.bloodPressure = record.getI32();
+        vitals.oxygenLevel = record.getI32();
+        vitals.temperature = record.getDouble();
+    }
+    spilledPatients.base = record.getU32();
+    uint32_t replacedCount = record.getU32();
+    for (uint32_t i = 0; i < replacedCount; i++) {
+        bool wasQueued = record.getU8() != 0;
+        spilledPatients.items.push_back(ReplacedRegistration(readPatient(record), wasQueued));
+    }
+    
+    uint32_t entryCount = record.getU32();
+    if (entryCount > entries.getCapacity()) {
+        throw std::runtime_error("Corrupt undo history!");
+    }
+    for (uint32_t i = 0; i < entryCount; i++) {
+        UndoEntry entry = makeEntry(static_cast<OperationType>(record.getU8()), NO_SYMBOL);
+        entry.flags = record.getU8();
+        entry.statusBefore = record.getU8();
+        entry.statusAfter = record.getU8();
+        entry.subject = record.getU32();
+        if (entry.operation == OperationType::VITALS_UPDATED && !(entry.flags & UndoEntry::SPILLED)) {
+            entry.payload.vitals.heartRate = static_cast<int16_t>(record.getI32());
+            entry.payload.vitals.bloodPressure = static_cast<int16_t>(record.getI32());
+            entry.payload.vitals.oxygenLevel = static_cast<int16_t>(record.getI32());
+            entry.payload.vitals.temperatureCenti = static_cast<int16_t>(record.getI32());
+        } else {
+            entry.payload.spill.first = record.getU32();
+            entry.payload.spill.count = record.getU32();
+        }
+        if (!isIntact(entry)) {
+            throw std::runtime_error("Corrupt undo history!");
+        }
+        entries.push(entry);
+    }
+}
+
+bool UndoJournal::isIntact(const UndoEntry& entry) const {
+    if (static_cast<size_t>(entry.operation) >= OPERATION_COUNT) return false;
+    if (entry.subject != NO_SYMBOL && !isSymbol(entry.subject)) return false;
+    
+    switch (entry.operation) {
+        case OperationType::PATIENT_TRANSFERRED:
+            return isSymbol(entry.payload.move.from) && isSymbol(entry.payload.move.to);
+        case OperationType::STAFF_ASSIGNED:
+            return isSymbol(entry.payload.staff.staff) &&
+                   (entry.payload.staff.previousPatient == NO_SYMBOL || 
+                    isSymbol(entry.payload.staff.previousPatient));
+        default:
+            break;
+    }
+    if (!(entry.flags & UndoEntry::SPILLED)) return true;
+    
+    // Spills must lie inside their side storage
+    uint64_t first = entry.payload.spill.first;
+    uint64_t end = first + entry.payload.spill.count;
+    switch (entry.operation) {
+        case OperationType::PATIENT_REGISTERED:
+            return first >= spilledPatients.base && end <= spilledPatients.end() && end == first + 1;
+        case OperationType::VITALS_UPDATED:
+            return first >= spilledVitals.base && end <= spilledVitals.end() && end == first + 1;
+        case OperationType::PATIENTS_BATCH_REGISTERED: {
+            if (first < spilledSymbols.base || end > spilledSymbols.end() || end < first + BATCH_HEADER) {
+                return false;
+            }
+            uint64_t replacedFirst = spilledSymbols.at(entry.payload.spill.first + 1);
+            uint64_t replacedEnd = replacedFirst + spilledSymbols.at(entry.payload.spill.first);
+            if (replacedFirst < spilledPatients.base || replacedEnd > spilledPatients.end()) return false;
+            for (uint64_t i = first + BATCH_HEADER; i < end; i++) {
+                if (!isSymbol(spilledSymbols.at(static_cast<uint32_t>(i)))) return false;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+std::string UndoJournal::getOperationString(OperationType operation) {
+    size_t index = static_cast<size_t>(operation);
+    return index < OPERATION_COUNT ? OPERATION_NAMES[index] : "Unknown Operation";
+}
+
+std::string UndoJournal::getDescription(OperationType operation) {
+    size_t index = static_cast<size_t>(operation);
+    return index < OPERATION_COUNT ? DESCRIPTIONS[index] : "";
+}
+
+void UndoJournal::display(const UndoEntry& entry) const {
+    std::cout << "State: " << getOperationString(entry.operation) << " - "
+              << getDescription(entry.operation);
+    if (entry.operation == OperationType::PATIENTS_BATCH_REGISTERED) {
+        std::cout << " [Patients: " << entry.payload.spill.count - BATCH_HEADER + replacedCount(entry) << "]\n";
+    } else {
+        std::cout << " [Patient: " << symbols[entry.subject] << "]\n";
+    }
+}
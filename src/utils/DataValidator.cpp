@@ -15,6 +15,19 @@ bool DataValidator::validatePatientData(const Patient& patient) {
     return true;
 }
 
+size_t DataValidator::validatePatientBatch(const std::vector<Patient>& patients, 
+                                           std::vector<bool>& valid) {
+    valid.assign(patients.size(), false);
+    size_t passed = 0;
+    for (size_t i = 0; i < patients.size(); i++) {
+        const Patient& patient = patients[i];
+        valid[i] = validatePatientID(patient.getPatientID()) && 
+                   validateVitalSigns(patient.getVitalSigns());
+        if (valid[i]) passed++;
+    }
+    return passed;
+}
+
 bool DataValidator::validateVitalSigns(const VitalSigns& vitals) {
     if (vitals.heartRate < 0 || vitals.heartRate > 300) return false;
     if (vitals.bloodPressure < 0 || vitals.bloodPressure > 300) return false;
@@ -25,11 +38,15 @@ bool DataValidator::validateVitalSigns(const VitalSigns& vitals) {
 }
 
 bool DataValidator::validatePatientID(const std::string& id) {
-    return !id.empty() && id.length() >= 3;
+    return !id.empty() && id.length() >= 3 && id.length() <= PatientId::MAX_LENGTH;
+}
+
+bool DataValidator::validatePatientID(const PatientId& id) {
+    return id.length() >= 3;
 }
 
 bool DataValidator::validateRoomData(const HospitalRoom& room) {
-    return validateNonEmpty(room.getRoomID()) && 
+    return !room.getRoomID().empty() && 
            validateCoordinates(room.getPosition());
 }
 
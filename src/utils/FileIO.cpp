@@ -0,0 +1,149 @@
+#include "../../include/utils/FileIO.hpp"
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+int FileIO::openReadWrite(const std::string& path) {
+    return _open(path.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+bool FileIO::truncate(int fd, uint64_t length) { return _chsize_s(fd, length) == 0; }
+bool FileIO::seekToEnd(int fd) { return _lseeki64(fd, 0, SEEK_END) >= 0; }
+static long writeSome(int fd, const char* data, size_t size) {
+    return _write(fd, data, static_cast<unsigned>(size));
+}
+bool FileIO::sync(int fd) { return _commit(fd) == 0; }
+void FileIO::close(int fd) { _close(fd); }
+#else
+int FileIO::openReadWrite(const std::string& path) {
+    return ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+}
+bool FileIO::truncate(int fd, uint64_t length) { return ::ftruncate(fd, static_cast<off_t>(length)) == 0; }
+bool FileIO::seekToEnd(int fd) { return ::lseek(fd, 0, SEEK_END) >= 0; }
+static long writeSome(int fd, const char* data, size_t size) {
+    return static_cast<long>(::write(fd, data, size));
+}
+bool FileIO::sync(int fd) { return ::fsync(fd) == 0; }
+void FileIO::close(int fd) { ::close(fd); }
+#endif
+
+bool FileIO::writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        long written = writeSome(fd, data, size);
+        if (written <= 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// The rename itself must reach the disk too, or a crash can bring back the old name
+static bool renameDurably(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (std::rename(from.c_str(), to.c_str()) != 0) return false;
+    size_t slash = to.find_last_of('/');
+    std::string directory = (slash == std::string::npos) ? "." : to.substr(0, slash + 1);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+bool FileIO::replaceFile(const std::string& path, const char* data, size_t size) {
+    std::string temporary = path + ".tmp";
+    int fd = openReadWrite(temporary);
+    if (fd < 0) return false;
+    bool written = truncate(fd, 0) && writeAll(fd, data, size) && sync(fd);
+    close(fd);
+    if (!written) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return renameDurably(temporary, path);
+}
+
+// Reflected polynomial, one table lookup per byte
+struct Crc32Table {
+    uint32_t entries[256];
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+uint32_t FileIO::crc32(const char* data, size_t size, uint32_t crc) {
+    static const Crc32Table table;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table.entries[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+MappedFile::MappedFile(const std::string& path) : bytes(nullptr), length(0), mapping(nullptr) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + "!");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read " + path + "!");
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0) {
+        void* view = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view != MAP_FAILED) {
+            ::madvise(view, length, MADV_SEQUENTIAL);
+            mapping = view;
+            bytes = static_cast<const char*>(view);
+        }
+    }
+    ::close(fd);
+    if (mapping || length == 0) return;
+#endif
+    // No mmap (or it failed): read the whole file instead
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open " + path + "!");
+    }
+    fallback.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bytes = fallback.data();
+    length = fallback.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapping) {
+        ::munmap(mapping, length);
+    }
+#endif
+}
@@ -4,6 +4,7 @@
 
 std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> PerformanceMonitor::timers;
 std::unordered_map<std::string, long long> PerformanceMonitor::durations;
+std::unordered_map<std::string, long long> PerformanceMonitor::counters;
 
 void PerformanceMonitor::startTimer(const std::string& operationName) {
     timers[operationName] = std::chrono::high_resolution_clock::now();
@@ -21,6 +22,15 @@ long long PerformanceMonitor::stopTimer(const std::string& operationName) {
     return duration;
 }
 
+void PerformanceMonitor::recordCount(const std::string& counterName, long long value) {
+    counters[counterName] = value;
+}
+
+long long PerformanceMonitor::getCount(const std::string& counterName) {
+    auto it = counters.find(counterName);
+    return (it != counters.end()) ? it->second : 0;
+}
+
 void PerformanceMonitor::displayReport() {
     std::cout << "\n╔════════════════════════════════════════════════════════════╗\n";
     std::cout << "║              PERFORMANCE MONITORING REPORT                 ║\n";
@@ -35,6 +45,16 @@ void PerformanceMonitor::displayReport() {
                   << (pair.second / 1000.0) << " ║\n";
     }
     
+    if (!counters.empty()) {
+        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+        std::cout << "║ Counter                                              Count ║\n";
+        std::cout << "╠════════════════════════════════════════════════════════════╣\n";
+        for (const auto& pair : counters) {
+            std::cout << "║ " << std::setw(35) << std::left << pair.first 
+                      << std::setw(23) << std::right << pair.second << " ║\n";
+        }
+    }
+    
     std::cout << "╚════════════════════════════════════════════════════════════╝\n";
 }
 
@@ -57,4 +77,5 @@ void PerformanceMonitor::displayComplexityAnalysis() {
 void PerformanceMonitor::reset() {
     timers.clear();
     durations.clear();
+    counters.clear();
 }
\ No newline at end of file
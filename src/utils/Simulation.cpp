@@ -23,8 +23,8 @@ Patient Simulation::generateRandomPatient(int id) {
     bool isCritical = (std::rand() % 100) < 30; // 30% critical
     VitalSigns vitals = generateRandomVitals(isCritical);
     
-    std::string locations[] = {"ENTRANCE", "ER", "WAITING", "AMBULANCE"};
-    std::string location = locations[std::rand() % 4];
+    static const LocationId locations[] = {"ENTRANCE", "ER", "WAITING", "AMBULANCE"};
+    const LocationId& location = locations[std::rand() % 4];
     
     return Patient(ss.str(), vitals, location);
 }
@@ -49,6 +49,33 @@ VitalSigns Simulation::generateRandomVitals(bool critical) {
     return vitals;
 }
 
+void Simulation::generateCampusLayout(Graph& layout, int rows, int cols, unsigned seed) {
+    std::srand(seed);
+    
+    std::vector<LocationId> names;
+    names.reserve(rows * cols);
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            std::stringstream ss;
+            ss << "N_" << r << "_" << c;
+            names.push_back(ss.str());
+            layout.addNode(names.back(), Coordinates(c * 10.0, r * 10.0));
+        }
+    }
+    
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            const LocationId& node = names[r * cols + c];
+            if (c + 1 < cols) {
+                layout.addBidirectionalEdge(node, names[r * cols + c + 1], 10 + std::rand() % 5);
+            }
+            if (r + 1 < rows) {
+                layout.addBidirectionalEdge(node, names[(r + 1) * cols + c], 10 + std::rand() % 5);
+            }
+        }
+    }
+}
+
 SimulationResults Simulation::runEmergencySimulation(const SimulationConfig& config) {
     SimulationResults results;
     
@@ -0,0 +1,73 @@
+#include "../../include/utils/WorkerPool.hpp"
+
+WorkerPool::WorkerPool()
+    : job(nullptr), activeWorkers(0), unfinished(0), generation(0), stopping(false) {}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(unsigned participants, const std::function<void(unsigned)>& work) {
+    if (participants <= 1) {
+        work(0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        while (threads.size() < participants - 1) {
+            unsigned participant = static_cast<unsigned>(threads.size()) + 1;
+            threads.push_back(std::thread(&WorkerPool::workerLoop, this, participant, generation));
+        }
+        job = &work;
+        activeWorkers = participants - 1;
+        unfinished = activeWorkers;
+        generation++;
+    }
+    wakeWorkers.notify_all();
+    
+    // The workers read work and the caller's state, so never unwind past them
+    try {
+        work(0);
+    } catch (...) {
+        waitForWorkers();
+        throw;
+    }
+    waitForWorkers();
+}
+
+void WorkerPool::waitForWorkers() {
+    std::unique_lock<std::mutex> guard(lock);
+    batchDone.wait(guard, [this]() { return unfinished == 0; });
+    job = nullptr;
+}
+
+void WorkerPool::workerLoop(unsigned participant, uint64_t seen) {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        wakeWorkers.wait(guard, [this, seen]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+        if (participant > activeWorkers) continue;      // smaller batch; sit this one out
+        
+        const std::function<void(unsigned)>& work = *job;
+        guard.unlock();
+        work(participant);
+        guard.lock();
+        if (--unfinished == 0) {
+            batchDone.notify_one();
+        }
+    }
+}
+
+unsigned WorkerPool::getThreadCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<unsigned>(threads.size());
+}
@@ -0,0 +1,278 @@
+#include "../../include/utils/WriteAheadLog.hpp"
+#include "../../include/utils/FileIO.hpp"
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+const uint32_t WriteAheadLog::FORMAT_VERSION;
+const size_t WriteAheadLog::HEADER_SIZE;
+const size_t WriteAheadLog::EAGER_COMMIT_BYTES;
+
+static const char MAGIC[8] = {'H', 'E', 'R', 'O', 'S', 'W', 'A', 'L'};
+
+static uint32_t readU32(const char* data) {
+    RecordReader reader(data, 4);
+    return reader.getU32();
+}
+
+void WriteAheadLog::putHeader(RecordWriter& header, uint64_t firstPosition) {
+    for (char c : MAGIC) header.putU8(static_cast<uint8_t>(c));
+    header.putU32(FORMAT_VERSION);
+    header.putU32(0);
+    header.putU64(firstPosition);
+}
+
+uint64_t WriteAheadLog::replay(const std::string& path, uint64_t from,
+                               const std::function<void(uint8_t type, RecordReader& payload)>& apply,
+                               uint64_t& endPosition) {
+    endPosition = from;
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file) return 0;
+    std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    
+    if (bytes.size() < HEADER_SIZE || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        readU32(bytes.data() + 8) != FORMAT_VERSION) {
+        return 0;
+    }
+    RecordReader header(bytes.data() + 16, 8);
+    uint64_t position = header.getU64();
+    if (position > from) {
+        throw std::runtime_error("Journal " + path + " starts at record " + std::to_string(position) +
+                                 ", after the " + std::to_string(from) + " already loaded!");
+    }
+    
+    size_t offset = HEADER_SIZE;
+    while (bytes.size() - offset >= 8) {
+        uint32_t length = readU32(&bytes[offset]);
+        uint32_t crc = readU32(&bytes[offset + 4]);
+        if (length == 0 || length > bytes.size() - offset - 8) break;      // torn tail
+        
+        const char* body = &bytes[offset + 8];
+        if (FileIO::crc32(body, length) != crc) break;                     // corrupt record
+        
+        // Records a loaded snapshot already holds are checked but skipped
+        if (position >= from) {
+            RecordReader payload(body + 1, length - 1);
+            apply(static_cast<uint8_t>(body[0]), payload);
+        }
+        position++;
+        offset += 8 + length;
+    }
+    if (position < from) {
+        throw std::runtime_error("Journal " + path + " ends at record " + std::to_string(position) +
+                                 ", before the " + std::to_string(from) + " already loaded!");
+    }
+    endPosition = position;
+    return offset;
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& journalPath, uint64_t validLength,
+                             unsigned intervalMicros, uint64_t nextPosition)
+    : path(journalPath), fd(-1), commitIntervalMicros(intervalMicros), startPosition(nextPosition),
+      fileLength(validLength), appendedRecords(0), durableRecords(0), commitCount(0),
+      syncRequested(false), discardRequested(false), stopping(false) {
+    fd = FileIO::openReadWrite(path);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open journal " + path + "!");
+    }
+    
+    bool ready;
+    if (validLength < HEADER_SIZE) {
+        // New file, or not a journal we can extend: start over
+        RecordWriter header;
+        putHeader(header, nextPosition);
+        ready = FileIO::truncate(fd, 0) && FileIO::writeAll(fd, header.data(), header.size()) && FileIO::sync(fd);
+        fileLength = header.size();
+    } else {
+        // Drop a torn tail so new records follow the last intact one
+        ready = FileIO::truncate(fd, validLength) && FileIO::seekToEnd(fd) && FileIO::sync(fd);
+    }
+    if (!ready) {
+        FileIO::close(fd);
+        throw std::runtime_error("Cannot prepare journal " + path + "!");
+    }
+    
+    discardMark.position = 0;
+    discardMark.offset = 0;
+    // Groups are written early at EAGER_COMMIT_BYTES, so the two buffers
+    // only grow past this when appends outrun the disk
+    pending.reserve(2 * EAGER_COMMIT_BYTES);
+    committer = std::thread(&WriteAheadLog::commitLoop, this);
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wakeCommitter.notify_one();
+    committer.join();
+    FileIO::close(fd);
+}
+
+void WriteAheadLog::checkFailure() const {
+    if (!failure.empty()) {
+        throw std::runtime_error(failure);
+    }
+}
+
+void WriteAheadLog::append(uint8_t type, const RecordWriter& payload) {
+    // Frame and checksum outside the lock; only the copy is serialized
+    char frame[9];
+    uint32_t length = static_cast<uint32_t>(payload.size() + 1);
+    char typeByte = static_cast<char>(type);
+    uint32_t crc = FileIO::crc32(payload.data(), payload.size(), FileIO::crc32(&typeByte, 1));
+    for (int i = 0; i < 4; i++) {
+        frame[i] = static_cast<char>(length >> (8 * i));
+        frame[4 + i] = static_cast<char>(crc >> (8 * i));
+    }
+    frame[8] = typeByte;
+    
+    bool wake;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        checkFailure();
+        size_t before = pending.size();
+        pending.insert(pending.end(), frame, frame + sizeof(frame));
+        pending.insert(pending.end(), payload.data(), payload.data() + payload.size());
+        appendedRecords++;
+        // The committer sleeps while idle; wake it for the first record of a
+        // group and again once the group is big enough to write early
+        wake = (before == 0) || (before < EAGER_COMMIT_BYTES && pending.size() >= EAGER_COMMIT_BYTES);
+    }
+    if (wake) wakeCommitter.notify_one();
+}
+
+void WriteAheadLog::sync() {
+    std::unique_lock<std::mutex> guard(lock);
+    checkFailure();
+    uint64_t target = appendedRecords;
+    if (durableRecords >= target && !discardRequested) return;
+    
+    syncRequested = true;
+    wakeCommitter.notify_one();
+    committed.wait(guard, [this, target]() {
+        return (durableRecords >= target && !discardRequested) || !failure.empty();
+    });
+    checkFailure();
+}
+
+WriteAheadLog::Mark WriteAheadLog::mark() {
+    sync();
+    std::lock_guard<std::mutex> guard(lock);
+    Mark end;
+    end.position = startPosition + durableRecords;
+    end.offset = fileLength;
+    return end;
+}
+
+void WriteAheadLog::discardBefore(const Mark& mark) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        discardRequested = true;
+        discardMark = mark;
+    }
+    wakeCommitter.notify_one();
+}
+
+void WriteAheadLog::startOver(const Mark& mark) {
+    uint64_t length;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        length = fileLength;
+    }
+    
+    // The records from mark on, behind a header that starts counting there
+    RecordWriter segment;
+    putHeader(segment, mark.position);
+    std::vector<char> tail(length - mark.offset);
+    std::ifstream file(path.c_str(), std::ios::binary);
+    bool copied = file.seekg(static_cast<std::streamoff>(mark.offset)) &&
+                  file.read(tail.data(), static_cast<std::streamsize>(tail.size()));
+    file.close();
+    
+    // Close first: Windows will not rename over an open file. A failed
+    // replace leaves the old journal whole, so appending simply goes on there.
+    FileIO::close(fd);
+    bool replaced = false;
+    if (copied) {
+        std::vector<char> bytes = segment.release();
+        bytes.insert(bytes.end(), tail.begin(), tail.end());
+        replaced = FileIO::replaceFile(path, bytes.data(), bytes.size());
+        if (replaced) length = bytes.size();
+    }
+    fd = FileIO::openReadWrite(path);
+    
+    std::lock_guard<std::mutex> guard(lock);
+    if (fd < 0 || !FileIO::seekToEnd(fd)) {
+        failure = "Journal " + path + " could not be reopened!";
+        return;
+    }
+    fileLength = length;
+}
+
+void WriteAheadLog::writeDurably(const std::vector<char>& bytes) {
+    if (!FileIO::writeAll(fd, bytes.data(), bytes.size()) || !FileIO::sync(fd)) {
+        std::lock_guard<std::mutex> guard(lock);
+        failure = "Journal write to " + path + " failed!";
+    }
+}
+
+void WriteAheadLog::commitLoop() {
+    std::vector<char> writing;
+    writing.reserve(2 * EAGER_COMMIT_BYTES);
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        // Idle until a record arrives, then give the group one interval to fill
+        wakeCommitter.wait(guard, [this]() { return stopping || discardRequested || !pending.empty(); });
+        if (!stopping && !pending.empty()) {
+            wakeCommitter.wait_for(guard, std::chrono::microseconds(commitIntervalMicros), [this]() {
+                return stopping || syncRequested || discardRequested || pending.size() >= EAGER_COMMIT_BYTES;
+            });
+        }
+        syncRequested = false;
+        
+        if (!pending.empty()) {
+            writing.swap(pending);
+            uint64_t target = appendedRecords;
+            guard.unlock();
+            writeDurably(writing);
+            guard.lock();
+            if (!failure.empty()) {
+                // Nothing later can be made durable either; waiters see the failure
+                committed.notify_all();
+                return;
+            }
+            fileLength += writing.size();
+            writing.clear();
+            durableRecords = target;
+            commitCount++;
+        }
+        
+        // Everything up to here is in the file, so the copied tail is complete
+        if (discardRequested) {
+            Mark mark = discardMark;
+            guard.unlock();
+            startOver(mark);
+            guard.lock();
+            discardRequested = false;
+            if (!failure.empty()) {
+                committed.notify_all();
+                return;
+            }
+        }
+        committed.notify_all();
+        if (stopping && pending.empty()) break;
+    }
+}
+
+uint64_t WriteAheadLog::getRecordCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return appendedRecords;
+}
+
+uint64_t WriteAheadLog::getCommitCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return commitCount;
+}
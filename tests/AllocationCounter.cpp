@@ -0,0 +1,62 @@
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations(0);
+
+size_t allocationCount() {
+    return allocations;
+}
+
+static void* allocate(size_t size) {
+    allocations++;
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(size_t size) {
+    void* block = allocate(size);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void* operator new[](size_t size) {
+    void* block = allocate(size);
+    if (!block) throw std::bad_alloc();
+    return block;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    std::free(block);
+}
+
+// Sized forms exist from C++14 on, when the compiler emits them
+#ifdef __cpp_sized_deallocation
+void operator delete(void* block, size_t) noexcept {
+    std::free(block);
+}
+
+void operator delete[](void* block, size_t) noexcept {
+    std::free(block);
+}
+#endif
@@ -0,0 +1,12 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// Heap allocations made so far by any form of operator new. Linking
+// AllocationCounter.cpp into a test replaces the global allocation
+// functions; they live in their own translation unit so the compiler
+// never pairs an inlined malloc with a delete expression.
+size_t allocationCount();
+
+#endif // ALLOCATION_COUNTER_HPP
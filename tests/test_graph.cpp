@@ -1,7 +1,12 @@
 #include "../include/algorithms/Graph.hpp"
 #include "../include/algorithms/DijkstraRouter.hpp"
+#include "../include/algorithms/MSTGenerator.hpp"
+#include "../include/utils/Simulation.hpp"
 #include <iostream>
+#include <cstdlib>
 #include <cassert>
+#include <limits>
+#include <stdexcept>
 
 void testGraphConstruction() {
     std::cout << "\n🧪 Testing Graph Construction...\n";
@@ -48,6 +53,547 @@ void testDijkstraAlgorithm() {
     std::cout << "✓ Dijkstra's algorithm test passed!\n";
 }
 
+void testMultipleDestinations() {
+    std::cout << "\n🧪 Testing One-Pass Multi-Destination Routing...\n";
+    
+    Graph g;
+    g.addNode("A", Coordinates(0, 0));
+    g.addNode("B", Coordinates(1, 0));
+    g.addNode("C", Coordinates(2, 0));
+    g.addNode("D", Coordinates(3, 0));
+    g.addNode("E", Coordinates(4, 0));
+    
+    g.addBidirectionalEdge("A", "B", 4);
+    g.addBidirectionalEdge("A", "C", 2);
+    g.addBidirectionalEdge("B", "C", 1);
+    g.addBidirectionalEdge("B", "D", 5);
+    g.addBidirectionalEdge("C", "D", 8);
+    
+    DijkstraRouter router(&g);
+    std::vector<LocationId> destinations = {"D", "B", "A", "E", "Z", "B"};
+    std::vector<RouteInfo> routes = router.findPathsToMultipleDestinations("A", destinations);
+    
+    assert(routes.size() == destinations.size());
+    assert(routes[0].totalDistance == 8);
+    assert(routes[0].nodeCount == 4);
+    assert(routes[1].totalDistance == 3);
+    assert(routes[2].nodeCount == 1 && routes[2].totalDistance == 0);
+    assert(routes[3].path.empty());     // E is unreachable
+    assert(routes[4].path.empty());     // Z does not exist
+    assert(routes[5].totalDistance == 3);
+    
+    // Matches independent point-to-point queries
+    for (size_t i = 0; i < 3; i++) {
+        RouteInfo single = router.findShortestPath("A", destinations[i]);
+        assert(single.totalDistance == routes[i].totalDistance);
+        assert(single.path == routes[i].path);
+    }
+    
+    std::cout << "✓ Multi-destination routing test passed!\n";
+}
+
+void testBucketQueueRouting() {
+    std::cout << "\n🧪 Testing Dial's Bucket-Queue Routing...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 25, 25);
+    g.addEdge("N_3_3", "N_3_4", 0);         // zero-weight corridor
+    g.addNode("ISOLATED", Coordinates(500, 500));
+    
+    DijkstraRouter dial(&g);
+    DijkstraRouter heap(&g);
+    heap.setBucketQueueEnabled(false);
+    assert(dial.usesBucketQueue());
+    assert(!heap.usesBucketQueue());
+    
+    std::srand(11);
+    for (int i = 0; i < 100; i++) {
+        std::string from = "N_" + std::to_string(std::rand() % 25) + "_" + std::to_string(std::rand() % 25);
+        std::string to = "N_" + std::to_string(std::rand() % 25) + "_" + std::to_string(std::rand() % 25);
+        
+        RouteInfo bucketRoute = dial.findShortestPath(from, to, RoutingMode::DIJKSTRA);
+        RouteInfo heapRoute = heap.findShortestPath(from, to, RoutingMode::DIJKSTRA);
+        assert(bucketRoute.totalDistance == heapRoute.totalDistance);
+        assert(bucketRoute.path.front() == from && bucketRoute.path.back() == to);
+    }
+    assert(dial.findShortestPath("N_3_3", "N_3_4", RoutingMode::DIJKSTRA).totalDistance == 0);
+    assert(dial.findShortestPath("N_0_0", "ISOLATED", RoutingMode::DIJKSTRA).path.empty());
+    
+    std::vector<LocationId> destinations = {"N_24_24", "N_0_24", "N_12_12", "ISOLATED"};
+    std::vector<RouteInfo> bucketRoutes = dial.findPathsToMultipleDestinations("N_0_0", destinations);
+    std::vector<RouteInfo> heapRoutes = heap.findPathsToMultipleDestinations("N_0_0", destinations);
+    for (size_t i = 0; i < destinations.size(); i++) {
+        assert(bucketRoutes[i].totalDistance == heapRoutes[i].totalDistance);
+    }
+    
+    // A single fractional corridor falls back to the binary heap
+    g.addBidirectionalEdge("N_0_0", "N_0_1", 2.5);
+    assert(!dial.usesBucketQueue());
+    assert(dial.findShortestPath("N_0_0", "N_0_1", RoutingMode::DIJKSTRA).totalDistance == 2.5);
+    
+    std::cout << "✓ Bucket-queue routing test passed!\n";
+}
+
+void testAStarRouting() {
+    std::cout << "\n🧪 Testing A* Routing...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 30, 30);
+    
+    DijkstraRouter router(&g);
+    assert(router.validateHeuristic());
+    
+    RouteInfo plain = router.findShortestPath("N_15_2", "N_15_27", RoutingMode::DIJKSTRA);
+    size_t plainSettled = router.getLastSettledCount();
+    RouteInfo guided = router.findShortestPath("N_15_2", "N_15_27", RoutingMode::A_STAR);
+    size_t guidedSettled = router.getLastSettledCount();
+    
+    assert(!guided.path.empty());
+    assert(guided.totalDistance == plain.totalDistance);
+    assert(guidedSettled < plainSettled);
+    
+    // A corridor shorter than the straight line invalidates the heuristic
+    g.addBidirectionalEdge("N_0_0", "N_29_29", 1);
+    assert(!router.validateHeuristic());
+    RouteInfo fallback = router.findShortestPath("N_0_0", "N_29_29", RoutingMode::A_STAR);
+    assert(fallback.totalDistance == 1);
+    
+    std::cout << "✓ A* routing test passed!\n";
+}
+
+void testBidirectionalRouting() {
+    std::cout << "\n🧪 Testing Bidirectional Dijkstra...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 25, 25);
+    g.addEdge("N_3_3", "N_20_20", 50);      // one-way shortcut
+    
+    DijkstraRouter router(&g);
+    const char* pairs[][2] = {
+        {"N_0_0", "N_24_24"}, {"N_3_3", "N_21_20"}, {"N_21_20", "N_3_3"},
+        {"N_12_12", "N_12_12"}, {"N_5_19", "N_18_2"}
+    };
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++) {
+        RouteInfo plain = router.findShortestPath(pairs[i][0], pairs[i][1], RoutingMode::DIJKSTRA);
+        RouteInfo bidir = router.findShortestPath(pairs[i][0], pairs[i][1], RoutingMode::BIDIRECTIONAL);
+        
+        assert(bidir.totalDistance == plain.totalDistance);
+        assert(bidir.path.front() == pairs[i][0]);
+        assert(bidir.path.back() == pairs[i][1]);
+        
+        // Path is made of real corridors adding up to the reported distance
+        double walked = 0.0;
+        for (size_t k = 0; k + 1 < bidir.path.size(); k++) {
+            double hop = std::numeric_limits<double>::infinity();
+            for (const Edge& edge : g.getEdges(bidir.path[k])) {
+                if (edge.to == bidir.path[k + 1] && edge.weight < hop) hop = edge.weight;
+            }
+            walked += hop;
+        }
+        assert(walked == bidir.totalDistance);
+    }
+    
+    // Disconnected target
+    g.addNode("ISOLATED", Coordinates(500, 500));
+    assert(router.findShortestPath("N_0_0", "ISOLATED", RoutingMode::BIDIRECTIONAL).path.empty());
+    
+    std::cout << "✓ Bidirectional routing test passed!\n";
+}
+
+void testContractionHierarchy() {
+    std::cout << "\n🧪 Testing Contraction Hierarchy Routing...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 20, 20);
+    g.addEdge("N_2_2", "N_17_15", 40);      // one-way shortcut
+    g.addNode("ISOLATED", Coordinates(500, 500));
+    
+    DijkstraRouter router(&g);
+    const HierarchyStats& stats = router.buildContractionHierarchy();
+    assert(router.hasContractionHierarchy());
+    assert(stats.nodeCount == 401);
+    assert(stats.memoryBytes > 0);
+    
+    std::srand(3);
+    for (int i = 0; i < 200; i++) {
+        std::string from = "N_" + std::to_string(std::rand() % 20) + "_" + std::to_string(std::rand() % 20);
+        std::string to = "N_" + std::to_string(std::rand() % 20) + "_" + std::to_string(std::rand() % 20);
+        if (i == 0) { from = "N_2_2"; to = "N_17_15"; }
+        
+        RouteInfo plain = router.findShortestPath(from, to, RoutingMode::DIJKSTRA);
+        RouteInfo ch = router.findShortestPath(from, to, RoutingMode::CONTRACTION_HIERARCHY);
+        assert(ch.totalDistance == plain.totalDistance);
+        
+        // Unpacked path consists of real corridors only
+        assert(ch.path.front() == from && ch.path.back() == to);
+        double walked = 0.0;
+        for (size_t k = 0; k + 1 < ch.path.size(); k++) {
+            double hop = std::numeric_limits<double>::infinity();
+            for (const Edge& edge : g.getEdges(ch.path[k])) {
+                if (edge.to == ch.path[k + 1] && edge.weight < hop) hop = edge.weight;
+            }
+            walked += hop;
+        }
+        assert(walked == ch.totalDistance);
+    }
+    assert(router.findShortestPath("N_0_0", "ISOLATED", RoutingMode::CONTRACTION_HIERARCHY).path.empty());
+    
+    // Any change to the graph invalidates the hierarchy
+    g.addBidirectionalEdge("N_0_0", "ISOLATED", 1000);
+    assert(!router.hasContractionHierarchy());
+    RouteInfo fallback = router.findShortestPath("N_0_1", "ISOLATED", RoutingMode::CONTRACTION_HIERARCHY);
+    assert(fallback.totalDistance == router.findShortestPath("N_0_1", "N_0_0").totalDistance + 1000);
+    
+    std::cout << "✓ Contraction hierarchy test passed!\n";
+}
+
+void testRouteCache() {
+    std::cout << "\n🧪 Testing Versioned Route Cache...\n";
+    
+    Graph g;
+    g.addNode("A", Coordinates(0, 0));
+    g.addNode("B", Coordinates(1, 0));
+    g.addNode("C", Coordinates(2, 0));
+    g.addBidirectionalEdge("A", "B", 4);
+    g.addBidirectionalEdge("B", "C", 4);
+    
+    DijkstraRouter router(&g);
+    router.setRouteCacheCapacity(2);
+    
+    assert(router.findShortestPath("A", "C").totalDistance == 8);
+    assert(router.getCacheMisses() == 1 && router.getCacheHits() == 0);
+    assert(router.findShortestPath("A", "C").totalDistance == 8);
+    assert(router.getCacheHits() == 1);
+    assert(router.getLastSettledCount() == 0);
+    
+    // Explicit-mode queries always search
+    router.findShortestPath("A", "C", RoutingMode::BIDIRECTIONAL);
+    assert(router.getCacheHits() == 1);
+    
+    // Least recently used entry is evicted first
+    router.findShortestPath("C", "A");
+    router.findShortestPath("A", "C");      // refresh A->C
+    router.findShortestPath("A", "B");      // evicts C->A
+    assert(router.getRouteCacheSize() == 2);
+    size_t misses = router.getCacheMisses();
+    router.findShortestPath("A", "C");
+    assert(router.getCacheMisses() == misses);
+    router.findShortestPath("C", "A");
+    assert(router.getCacheMisses() == misses + 1);
+    
+    // Any mutation bumps the version; stale routes are never served
+    uint64_t version = g.getVersion();
+    g.addEdge("A", "C", 5);
+    assert(g.getVersion() > version);
+    RouteInfo updated = router.findShortestPath("A", "C");
+    assert(updated.totalDistance == 5);
+    assert(updated.path.size() == 2);
+    
+    // Multi-destination results seed the cache for the same source
+    router.setRouteCacheCapacity(8);
+    std::vector<LocationId> destinations = {"B", "C"};
+    router.findPathsToMultipleDestinations("C", destinations);
+    size_t hits = router.getCacheHits();
+    assert(router.findShortestPath("C", "B").totalDistance == 4);
+    assert(router.getCacheHits() == hits + 1);
+    
+    // Unknown rooms are not cached
+    router.findShortestPath("A", "Z");
+    router.findShortestPath("A", "Z");
+    assert(router.getCacheHits() == hits + 1);
+    
+    std::cout << "✓ Route cache test passed!\n";
+}
+
+void testBatchRouting() {
+    std::cout << "\n🧪 Testing Parallel Batch Routing...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 40, 40);
+    
+    std::srand(9);
+    std::vector<std::pair<LocationId, LocationId>> queries;
+    for (int i = 0; i < 300; i++) {
+        queries.push_back(std::make_pair(
+            "N_" + std::to_string(std::rand() % 40) + "_" + std::to_string(std::rand() % 40),
+            "N_" + std::to_string(std::rand() % 40) + "_" + std::to_string(std::rand() % 40)));
+    }
+    queries.push_back(std::make_pair("N_0_0", "MISSING"));
+    
+    DijkstraRouter reference(&g);
+    const RoutingMode modes[] = {RoutingMode::DIJKSTRA, RoutingMode::BIDIRECTIONAL,
+                                 RoutingMode::A_STAR};
+    for (RoutingMode mode : modes) {
+        for (unsigned threads = 1; threads <= 4; threads *= 2) {
+            DijkstraRouter router(&g);
+            router.setRouteCacheCapacity(0);
+            router.setRoutingMode(mode);
+            router.setBatchThreadCount(threads);
+            
+            std::vector<RouteInfo> routes = router.findShortestPathsBatch(queries);
+            assert(routes.size() == queries.size());
+            for (size_t i = 0; i + 1 < queries.size(); i++) {
+                RouteInfo expected = reference.findShortestPath(queries[i].first, queries[i].second,
+                                                                RoutingMode::DIJKSTRA);
+                assert(routes[i].totalDistance == expected.totalDistance);
+                assert(routes[i].path.front() == queries[i].first);
+                assert(routes[i].path.back() == queries[i].second);
+            }
+            assert(routes.back().path.empty());
+        }
+    }
+    
+    // One router across batches: its workers are started once and kept,
+    // including through a smaller batch and a topology change
+    DijkstraRouter shared(&g);
+    shared.setRouteCacheCapacity(0);
+    const unsigned batchSizes[] = {4, 2, 4};
+    for (unsigned threads : batchSizes) {
+        shared.setBatchThreadCount(threads);
+        std::vector<RouteInfo> routes = shared.findShortestPathsBatch(queries);
+        assert(routes[7].totalDistance == reference.findShortestPath(queries[7].first, queries[7].second,
+                                                                     RoutingMode::DIJKSTRA).totalDistance);
+        assert(shared.getStartedWorkerCount() == 3);
+    }
+    Graph grown;
+    Simulation::generateCampusLayout(grown, 40, 40);
+    DijkstraRouter grownReference(&grown);
+    DijkstraRouter grownShared(&grown);
+    grownShared.setRouteCacheCapacity(0);
+    grownShared.setBatchThreadCount(3);
+    grownShared.findShortestPathsBatch(queries);
+    grown.addNode("ANNEX", Coordinates(-10, 0));
+    grown.addBidirectionalEdge("ANNEX", "N_0_0", 10);
+    std::vector<std::pair<LocationId, LocationId>> annexQueries(queries);
+    annexQueries[0] = std::make_pair(LocationId("ANNEX"), LocationId("N_39_39"));
+    std::vector<RouteInfo> regrown = grownShared.findShortestPathsBatch(annexQueries);
+    for (size_t i = 0; i + 1 < annexQueries.size(); i++) {
+        assert(regrown[i].totalDistance == grownReference.findShortestPath(
+            annexQueries[i].first, annexQueries[i].second, RoutingMode::DIJKSTRA).totalDistance);
+    }
+    assert(grownShared.getStartedWorkerCount() == 2);
+    
+    // Batch results feed the route cache, and maintained trees answer directly
+    DijkstraRouter cached(&g);
+    cached.setBatchThreadCount(2);
+    cached.maintainShortestPathTree("N_0_0");
+    std::vector<std::pair<LocationId, LocationId>> small(queries.begin(), queries.begin() + 20);
+    small.push_back(std::make_pair("N_0_0", "N_39_39"));
+    cached.findShortestPathsBatch(small);
+    size_t hits = cached.getCacheHits();
+    std::vector<RouteInfo> again = cached.findShortestPathsBatch(small);
+    assert(cached.getCacheHits() == hits + small.size());
+    assert(again.back().totalDistance == 
+           reference.findShortestPath("N_0_0", "N_39_39", RoutingMode::DIJKSTRA).totalDistance);
+    
+    std::cout << "✓ Batch routing test passed!\n";
+}
+
+void testDynamicCorridors() {
+    std::cout << "\n🧪 Testing Corridor Closures and Tree Repair...\n";
+    
+    Graph g;
+    Simulation::generateCampusLayout(g, 30, 30);
+    
+    // Graph-level operations patch the CSR view in place
+    const CompactGraph* view = &g.getCompactView();
+    uint64_t topology = g.getTopologyVersion();
+    assert(!g.disableEdge("N_0_0", "N_5_5"));
+    assert(g.disableEdge("N_0_0", "N_0_1"));
+    assert(&g.getCompactView() == view);
+    assert(g.getTopologyVersion() == topology);
+    assert(g.getWeightLog().size() == 1);
+    uint32_t a = view->indexOf("N_0_0");
+    for (uint32_t e = view->edgesBegin(a); e < view->edgesEnd(a); e++) {
+        if (view->nameOf(view->edgeTarget(e)) == "N_0_1") {
+            assert(view->edgeWeight(e) == std::numeric_limits<double>::infinity());
+        }
+    }
+    assert(g.enableEdge("N_0_0", "N_0_1"));
+    
+    DijkstraRouter router(&g);
+    router.setRouteCacheCapacity(0);
+    router.maintainShortestPathTree("N_0_0");
+    router.maintainShortestPathTree("N_15_15");
+    assert(router.isTreeMaintained("N_0_0"));
+    assert(router.getLastRepairCount() == 900);
+    assert(router.usesBucketQueue());
+    
+    // Random closures, reopenings and reweightings; tree routes must always
+    // match a from-scratch search
+    std::srand(5);
+    std::vector<std::pair<std::string, std::string>> closed;
+    for (int step = 0; step < 60; step++) {
+        int r = std::rand() % 29, c = std::rand() % 29;
+        std::string from = "N_" + std::to_string(r) + "_" + std::to_string(c);
+        std::string to = (std::rand() % 2) ? "N_" + std::to_string(r + 1) + "_" + std::to_string(c)
+                                           : "N_" + std::to_string(r) + "_" + std::to_string(c + 1);
+        int action = std::rand() % 3;
+        if (action == 0) {
+            g.disableEdge(from, to);
+            g.disableEdge(to, from);
+            closed.push_back(std::make_pair(from, to));
+        } else if (action == 1 && !closed.empty()) {
+            g.enableEdge(closed.back().first, closed.back().second);
+            g.enableEdge(closed.back().second, closed.back().first);
+            closed.pop_back();
+        } else {
+            double weight = 5 + std::rand() % 20;
+            g.updateEdgeWeight(from, to, weight);
+            g.updateEdgeWeight(to, from, weight);
+        }
+        
+        const char* sources[] = {"N_0_0", "N_15_15"};
+        for (const char* source : sources) {
+            for (int k = 0; k < 10; k++) {
+                std::string target = "N_" + std::to_string(std::rand() % 30) + "_" + 
+                                     std::to_string(std::rand() % 30);
+                RouteInfo repaired = router.findShortestPath(source, target);
+                RouteInfo fresh = router.findShortestPath(source, target, RoutingMode::DIJKSTRA);
+                assert(repaired.totalDistance == fresh.totalDistance);
+                assert(repaired.path.empty() == fresh.path.empty());
+            }
+        }
+    }
+    
+    // Both trees were just synchronized, so nothing they read is kept
+    assert(g.getWeightLog().empty());
+    assert(g.getWeightLogStart() == g.getWeightLogEnd());
+    
+    // Weights that would break the searches are refused and not logged
+    bool rejected = false;
+    try {
+        g.updateEdgeWeight("N_0_0", "N_0_1", -1.0);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    rejected = false;
+    try {
+        g.updateEdgeWeight("N_0_0", "N_0_1", std::numeric_limits<double>::quiet_NaN());
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    assert(g.getWeightLog().empty());
+    
+    // New corridors are held to the same rule, before anything changes
+    int edgesBefore = g.getEdgeCount();
+    uint64_t versionBefore = g.getVersion();
+    rejected = false;
+    try {
+        g.addBidirectionalEdge("N_0_0", "N_4_4", -3.0);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    rejected = false;
+    try {
+        g.addEdge("N_0_0", "N_4_4", std::numeric_limits<double>::quiet_NaN());
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    assert(g.getEdgeCount() == edgesBefore && g.getVersion() == versionBefore);
+    
+    // Repeated close/reopen cycles keep the log bounded, and a tree left
+    // behind by trimming rebuilds instead of replaying
+    for (int cycle = 0; cycle < 1000; cycle++) {
+        g.disableEdge("N_3_3", "N_3_4");
+        g.enableEdge("N_3_3", "N_3_4");
+    }
+    assert(g.getWeightLog().size() <= 2 * static_cast<size_t>(g.getVertexCount()));
+    g.disableEdge("N_0_0", "N_0_1");
+    g.disableEdge("N_0_0", "N_1_0");
+    RouteInfo cutOff = router.findShortestPath("N_0_0", "N_29_29");
+    assert(cutOff.path.empty());
+    assert(router.getLastRepairCount() == 1);     // rebuilt: only the source is labelled
+    g.enableEdge("N_0_0", "N_0_1");
+    g.enableEdge("N_0_0", "N_1_0");
+    assert(router.findShortestPath("N_0_0", "N_29_29").totalDistance ==
+           router.findShortestPath("N_0_0", "N_29_29", RoutingMode::DIJKSTRA).totalDistance);
+    
+    // A closure far from the source only touches the subtree behind it
+    Graph line;
+    for (int i = 0; i < 100; i++) {
+        line.addNode("L" + std::to_string(i), Coordinates(i, 0));
+        if (i > 0) line.addBidirectionalEdge("L" + std::to_string(i - 1), "L" + std::to_string(i), 1);
+    }
+    DijkstraRouter lineRouter(&line);
+    lineRouter.maintainShortestPathTree("L0");
+    line.disableEdge("L89", "L90");
+    assert(lineRouter.findShortestPath("L0", "L95").path.empty());
+    assert(lineRouter.getLastRepairCount() == 0);     // nothing left to re-label
+    line.enableEdge("L89", "L90");
+    assert(lineRouter.findShortestPath("L0", "L95").totalDistance == 95);
+    assert(lineRouter.getLastRepairCount() == 10);
+    
+    // Closed corridors never carry equipment runs
+    MSTGenerator mst(&line);
+    line.disableEdge("L49", "L50");
+    line.disableEdge("L50", "L49");
+    assert(mst.generateMinimumSpanningTree().edgeCount == 98);
+    
+    std::cout << "✓ Corridor closure test passed!\n";
+}
+
+void testCompactGraphView() {
+    std::cout << "\n🧪 Testing CSR Graph View...\n";
+    
+    Graph g;
+    g.addNode("A", Coordinates(0, 0));
+    g.addNode("B", Coordinates(1, 0));
+    g.addNode("C", Coordinates(1, 1));
+    
+    g.addBidirectionalEdge("A", "B", 10);
+    g.addEdge("B", "C", 15);
+    
+    const CompactGraph& view = g.getCompactView();
+    assert(view.getNodeCount() == 3);
+    assert(view.getEdgeCount() == 3);
+    
+    // Interning follows insertion order and round-trips
+    assert(view.indexOf("A") == 0);
+    assert(view.nameOf(view.indexOf("C")) == "C");
+    assert(view.indexOf("D") == CompactGraph::INVALID_NODE);
+    
+    uint32_t b = view.indexOf("B");
+    assert(view.edgesEnd(b) - view.edgesBegin(b) == 2);
+    assert(view.positionOf(b).x == 1);
+    
+    // Mutation drops the frozen view; the next call rebuilds it
+    g.addNode("D", Coordinates(2, 2));
+    g.addEdge("C", "D", 1);
+    assert(g.getCompactView().getNodeCount() == 4);
+    assert(g.getCompactView().getEdgeCount() == 4);
+    
+    std::cout << "✓ CSR graph view test passed!\n";
+}
+
+void testMinimumSpanningTree() {
+    std::cout << "\n🧪 Testing Kruskal's MST...\n";
+    
+    Graph g;
+    g.addNode("A", Coordinates(0, 0));
+    g.addNode("B", Coordinates(1, 0));
+    g.addNode("C", Coordinates(2, 0));
+    g.addNode("D", Coordinates(3, 0));
+    
+    g.addBidirectionalEdge("A", "B", 4);
+    g.addBidirectionalEdge("A", "C", 2);
+    g.addBidirectionalEdge("B", "C", 1);
+    g.addBidirectionalEdge("B", "D", 5);
+    g.addBidirectionalEdge("C", "D", 8);
+    
+    MSTGenerator mst(&g);
+    MSTResult result = mst.generateMinimumSpanningTree();
+    
+    assert(result.edgeCount == 3);
+    assert(result.totalWeight == 8); // B-C, A-C, B-D
+    
+    std::cout << "✓ MST test passed!\n";
+}
+
 int main() {
     std::cout << "╔══════════════════════════════════════╗\n";
     std::cout << "║   GRAPH ALGORITHM UNIT TESTS         ║\n";
@@ -55,6 +601,16 @@ int main() {
     
     testGraphConstruction();
     testDijkstraAlgorithm();
+    testMultipleDestinations();
+    testBucketQueueRouting();
+    testAStarRouting();
+    testBidirectionalRouting();
+    testContractionHierarchy();
+    testRouteCache();
+    testBatchRouting();
+    testDynamicCorridors();
+    testCompactGraphView();
+    testMinimumSpanningTree();
     
     std::cout << "\n✅ All Graph tests passed!\n\n";
     return 0;
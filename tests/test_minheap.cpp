@@ -1,7 +1,16 @@
 #include "../include/data_structures/MinHeap.hpp"
+#include "../include/data_structures/IndexedMinHeap.hpp"
+#include "../include/data_structures/PairingHeap.hpp"
+#include "../include/data_structures/StateStack.hpp"
 #include "../include/core/Patient.hpp"
 #include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
 #include <cassert>
+#include <memory>
 
 void testMinHeapBasicOperations() {
     std::cout << "\n🧪 Testing Min-Heap Basic Operations...\n";
@@ -53,6 +62,33 @@ void testMinHeapWithPatients() {
     std::cout << "✓ Patient heap test passed!\n";
 }
 
+void testPatientOrdering() {
+    std::cout << "\n🧪 Testing Patient ordering (lower severity score first)...\n";
+    
+    VitalSigns critical;
+    critical.heartRate = 40;
+    critical.bloodPressure = 80;
+    critical.oxygenLevel = 85;
+    
+    VitalSigns stable;
+    stable.heartRate = 80;
+    stable.bloodPressure = 120;
+    stable.oxygenLevel = 98;
+    
+    Patient sick("P001", critical, "ER");
+    Patient well("P002", stable, "ER");
+    
+    // operator< used to be inverted, so every min-heap of Patients
+    // surfaced the healthiest patient first
+    assert(sick.getSeverityScore() < well.getSeverityScore());
+    assert(sick < well);
+    assert(!(well < sick));
+    assert(well > sick);
+    assert(!(sick > well));
+    
+    std::cout << "✓ Patient ordering test passed!\n";
+}
+
 void testBuildHeap() {
     std::cout << "\n🧪 Testing Build Heap (O(n) construction)...\n";
     
@@ -66,6 +102,350 @@ void testBuildHeap() {
     std::cout << "✓ Build heap test passed!\n";
 }
 
+template<unsigned Arity>
+void checkArityAgainstSort() {
+    std::srand(100 + Arity);
+    std::vector<int> values;
+    for (int i = 0; i < 5000; i++) {
+        values.push_back(std::rand() % 2000);
+    }
+    
+    MinHeap<int, Arity> inserted;
+    for (int value : values) {
+        inserted.insert(value);
+    }
+    MinHeap<int, Arity> built;
+    built.buildHeap(values);
+    
+    std::sort(values.begin(), values.end());
+    for (int value : values) {
+        assert(inserted.extractMin() == value);
+        assert(built.extractMin() == value);
+    }
+    assert(inserted.isEmpty() && built.isEmpty());
+}
+
+void testHeapArity() {
+    std::cout << "\n🧪 Testing d-ary Heap Layouts (2, 4, 8)...\n";
+    
+    checkArityAgainstSort<2>();
+    checkArityAgainstSort<4>();
+    checkArityAgainstSort<8>();
+    
+    // Degenerate builds
+    MinHeap<int, 4> empty;
+    empty.buildHeap(std::vector<int>());
+    assert(empty.isEmpty());
+    empty.buildHeap(std::vector<int>(1, 42));
+    assert(empty.getMin() == 42);
+    
+    std::cout << "✓ Heap arity test passed!\n";
+}
+
+template<unsigned Arity>
+void checkIndexedHeapAgainstReference() {
+    // Random mix of operations, mirrored in a multimap of value -> handle
+    IndexedMinHeap<int, Arity> heap;
+    std::multimap<int, typename IndexedMinHeap<int, Arity>::Handle> reference;
+    std::vector<typename IndexedMinHeap<int, Arity>::Handle> live;
+    
+    std::srand(Arity);
+    for (int step = 0; step < 20000; step++) {
+        int action = std::rand() % 5;
+        if (action <= 1 || live.empty()) {
+            int value = std::rand() % 1000;
+            typename IndexedMinHeap<int, Arity>::Handle h = heap.insert(value);
+            reference.insert(std::make_pair(value, h));
+            live.push_back(h);
+        } else {
+            // Pick a live handle (updates/erases) or the root (extraction)
+            size_t pick = std::rand() % live.size();
+            if (action == 4) {
+                typename IndexedMinHeap<int, Arity>::Handle top = heap.getMinHandle();
+                for (pick = 0; live[pick] != top; pick++) {}
+            }
+            typename IndexedMinHeap<int, Arity>::Handle h = live[pick];
+            int oldValue = heap.get(h);
+            auto range = reference.equal_range(oldValue);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == h) { reference.erase(it); break; }
+            }
+            
+            if (action == 2) {
+                int value = std::rand() % 1000;
+                heap.update(h, value);
+                reference.insert(std::make_pair(value, h));
+            } else {
+                int value = (action == 3) ? heap.erase(h) : heap.extractMin();
+                assert(value == oldValue);
+                assert(action == 3 || reference.empty() || value <= reference.begin()->first);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+        }
+        
+        assert(heap.size() == static_cast<int>(reference.size()));
+        if (!reference.empty()) {
+            assert(heap.getMin() == reference.begin()->first);
+        }
+    }
+}
+
+void testIndexedHeap() {
+    std::cout << "\n🧪 Testing Indexed d-ary Heap (handles, decrease/increase-key, erase)...\n";
+    
+    IndexedMinHeap<int> heap;
+    IndexedMinHeap<int>::Handle a = heap.insert(50);
+    IndexedMinHeap<int>::Handle b = heap.insert(30);
+    IndexedMinHeap<int>::Handle c = heap.insert(40);
+    assert(heap.getMin() == 30 && heap.getMinHandle() == b);
+    
+    heap.decreaseKey(a, 10);
+    assert(heap.getMinHandle() == a);
+    heap.increaseKey(a, 60);
+    assert(heap.getMinHandle() == b);
+    assert(heap.erase(b) == 30);
+    assert(!heap.contains(b));
+    assert(heap.getMinHandle() == c);
+    
+    // Keys may only move in the promised direction
+    bool threw = false;
+    try { heap.decreaseKey(c, 90); } catch (const std::invalid_argument&) { threw = true; }
+    assert(threw);
+    threw = false;
+    try { heap.erase(b); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    
+    // Bulk insert: both the sift path (small batch) and the heapify path
+    IndexedMinHeap<int> bulk;
+    std::vector<IndexedMinHeap<int>::Handle> handles;
+    bulk.insertBatch(std::vector<int>(), handles);
+    assert(bulk.isEmpty() && handles.empty());
+    for (int round = 0; round < 3; round++) {
+        std::vector<int> batch;
+        int size = (round == 1) ? 2 : 1000;
+        for (int i = 0; i < size; i++) {
+            batch.push_back((i * 7919 + round) % 1000);
+        }
+        bulk.insertBatch(batch, handles);
+        assert(handles.size() == batch.size());
+        for (size_t i = 0; i < batch.size(); i++) {
+            assert(bulk.get(handles[i]) == batch[i]);
+        }
+    }
+    int last = -1;
+    while (!bulk.isEmpty()) {
+        int value = bulk.extractMin();
+        assert(value >= last);
+        last = value;
+    }
+    
+    checkIndexedHeapAgainstReference<2>();
+    checkIndexedHeapAgainstReference<4>();
+    checkIndexedHeapAgainstReference<8>();
+    
+    std::cout << "✓ Indexed heap test passed!\n";
+}
+
+template<unsigned Arity>
+void checkPeekSmallest() {
+    std::srand(300 + Arity);
+    std::vector<int> values;
+    MinHeap<int, Arity> heap;
+    IndexedMinHeap<int, Arity> indexed;
+    for (int i = 0; i < 3000; i++) {
+        int value = std::rand() % 500;
+        values.push_back(value);
+        heap.insert(value);
+        indexed.insert(value);
+    }
+    std::sort(values.begin(), values.end());
+    
+    const int ks[] = {0, 1, 10, 257, 3000, 5000};
+    for (int k : ks) {
+        std::vector<int> top = heap.peekSmallest(k);
+        std::vector<int> indexedTop = indexed.peekSmallest(k);
+        size_t expected = std::min(static_cast<size_t>(k), values.size());
+        assert(top.size() == expected && indexedTop.size() == expected);
+        for (size_t i = 0; i < expected; i++) {
+            assert(top[i] == values[i]);
+            assert(indexedTop[i] == values[i]);
+        }
+    }
+    
+    // Peeking is read-only
+    assert(heap.size() == 3000 && indexed.size() == 3000);
+    for (int value : values) {
+        assert(heap.extractMin() == value);
+    }
+}
+
+void testPeekSmallest() {
+    std::cout << "\n🧪 Testing Read-Only Top-k...\n";
+    
+    checkPeekSmallest<2>();
+    checkPeekSmallest<4>();
+    checkPeekSmallest<8>();
+    
+    MinHeap<int> empty;
+    assert(empty.peekSmallest(5).empty());
+    
+    std::cout << "✓ Top-k test passed!\n";
+}
+
+void testPairingHeap() {
+    std::cout << "\n🧪 Testing Pooled Pairing Heap (update, erase, meld)...\n";
+    
+    // Random operations mirrored in a multimap, with periodic melds of a
+    // second heap whose handles are re-based by the returned offset
+    typedef PairingHeap<int>::Handle Handle;
+    PairingHeap<int> heap;
+    std::multimap<int, Handle> reference;
+    std::vector<Handle> live;
+    
+    std::srand(77);
+    for (int step = 0; step < 20000; step++) {
+        int action = std::rand() % 6;
+        if (action <= 1 || live.empty()) {
+            int value = std::rand() % 1000;
+            Handle h = heap.insert(value);
+            reference.insert(std::make_pair(value, h));
+            live.push_back(h);
+        } else if (action == 5) {
+            PairingHeap<int> other;
+            std::vector<std::pair<int, Handle> > added;
+            for (int i = 0, n = std::rand() % 20; i < n; i++) {
+                int value = std::rand() % 1000;
+                added.push_back(std::make_pair(value, other.insert(value)));
+            }
+            if (!added.empty()) other.erase(added.back().second);   // leave a free slot
+            if (!added.empty()) added.pop_back();
+            Handle offset = heap.meld(std::move(other));
+            assert(other.isEmpty());
+            for (const auto& entry : added) {
+                assert(heap.get(entry.second + offset) == entry.first);
+                reference.insert(std::make_pair(entry.first, entry.second + offset));
+                live.push_back(entry.second + offset);
+            }
+        } else {
+            size_t pick = std::rand() % live.size();
+            if (action == 4) {
+                for (pick = 0; live[pick] != heap.getMinHandle(); pick++) {}
+            }
+            Handle h = live[pick];
+            int oldValue = heap.get(h);
+            auto range = reference.equal_range(oldValue);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == h) { reference.erase(it); break; }
+            }
+            
+            if (action == 2) {
+                int value = std::rand() % 1000;
+                heap.update(h, value);
+                reference.insert(std::make_pair(value, h));
+            } else {
+                int value = (action == 3) ? heap.erase(h) : heap.extractMin();
+                assert(value == oldValue);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+        }
+        
+        assert(heap.size() == static_cast<int>(reference.size()));
+        if (!reference.empty()) {
+            assert(heap.getMin() == reference.begin()->first);
+        }
+    }
+    
+    // Read-only top-k agrees with the reference order
+    std::vector<int> top = heap.peekSmallest(50);
+    auto it = reference.begin();
+    for (size_t i = 0; i < top.size(); i++, ++it) {
+        assert(top[i] == it->first);
+    }
+    
+    // A fresh heap hangs every node off the root; the walk still keeps
+    // only the candidates that can make the top k
+    PairingHeap<int> fresh;
+    std::vector<int> values;
+    for (int i = 0; i < 5000; i++) {
+        values.push_back((i * 7919) % 5000);
+        fresh.insert(values.back());
+    }
+    std::sort(values.begin(), values.end());
+    for (size_t k : {1, 2, 10, 100}) {
+        std::vector<int> freshTop = fresh.peekSmallest(k);
+        assert(freshTop.size() == k);
+        assert(std::equal(freshTop.begin(), freshTop.end(), values.begin()));
+    }
+    assert(fresh.peekSmallest(6000).size() == 5000);
+    assert(fresh.size() == 5000 && fresh.getMin() == 0);
+    
+    std::cout << "✓ Pairing heap test passed!\n";
+}
+
+void testStateStackRing() {
+    std::cout << "\n🧪 Testing State Stack Ring Buffer...\n";
+    
+    StateStack<int> stack(4);
+    for (int i = 1; i <= 10; i++) {
+        stack.push(i);
+    }
+    
+    // Only the newest four survive, in LIFO order
+    assert(stack.isFull());
+    assert(stack.size() == 4);
+    assert(stack.peek() == 10);
+    assert(stack.pop() == 10);
+    assert(stack.pop() == 9);
+    
+    // Refill across the wrap point after partial pops
+    stack.push(11);
+    stack.push(12);
+    stack.push(13);
+    assert(stack.size() == 4);
+    assert(stack.at(0) == 8 && stack.at(3) == 13);
+    int expected[] = {13, 12, 11, 8};
+    for (int i = 0; i < 4; i++) {
+        assert(stack.pop() == expected[i]);
+    }
+    assert(stack.isEmpty());
+    
+    bool threw = false;
+    try {
+        stack.pop();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // Resizing keeps the newest states
+    for (int i = 1; i <= 6; i++) {
+        stack.push(i);
+    }
+    stack.setCapacity(2);
+    assert(stack.getCapacity() == 2);
+    assert(stack.size() == 2);
+    assert(stack.pop() == 6);
+    assert(stack.pop() == 5);
+    stack.setCapacity(8);
+    for (int i = 0; i < 8; i++) {
+        stack.push(i);
+    }
+    assert(stack.isFull());
+    assert(stack.peek() == 7);
+    
+    // Move-only payloads: no copies on push or pop
+    StateStack<std::unique_ptr<int> > owners(3);
+    for (int i = 0; i < 5; i++) {
+        owners.push(std::unique_ptr<int>(new int(i)));
+    }
+    assert(*owners.pop() == 4);
+    assert(*owners.peek() == 3);
+    
+    std::cout << "✓ State stack ring buffer tests passed!\n";
+}
+
 int main() {
     std::cout << "╔══════════════════════════════════════╗\n";
     std::cout << "║   MIN-HEAP UNIT TESTS                ║\n";
@@ -73,7 +453,13 @@ int main() {
     
     testMinHeapBasicOperations();
     testMinHeapWithPatients();
+    testPatientOrdering();
     testBuildHeap();
+    testHeapArity();
+    testIndexedHeap();
+    testPeekSmallest();
+    testPairingHeap();
+    testStateStackRing();
     
     std::cout << "\n✅ All Min-Heap tests passed!\n\n";
     return 0;
@@ -0,0 +1,1249 @@
+#include "../include/data_structures/TriageQueue.hpp"
+#include "../include/data_structures/SeverityBucketQueue.hpp"
+#include "../include/data_structures/ConcurrentTriageQueue.hpp"
+#include "../include/data_structures/UndoJournal.hpp"
+#include "../include/data_structures/FlatHashMap.hpp"
+#include "../include/data_structures/PatientColumns.hpp"
+#include "../include/core/EmergencyResponseSystem.hpp"
+#include "../include/utils/WriteAheadLog.hpp"
+#include "../include/core/Patient.hpp"
+#include "AllocationCounter.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+#include <set>
+#include <map>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <streambuf>
+
+static VitalSigns makeVitals(int heartRate, int bloodPressure, int oxygenLevel) {
+    VitalSigns vitals;
+    vitals.heartRate = heartRate;
+    vitals.bloodPressure = bloodPressure;
+    vitals.oxygenLevel = oxygenLevel;
+    return vitals;
+}
+
+void testTriageOrdering() {
+    std::cout << "\n🧪 Testing Triage Queue Ordering...\n";
+    
+    TriageQueue queue;
+    queue.addPatient(Patient("P001", makeVitals(80, 120, 98), "ER"));      // 100
+    queue.addPatient(Patient("P002", makeVitals(40, 80, 85), "ER"));       // 10
+    queue.addPatient(Patient("P003", makeVitals(105, 120, 98), "ER"));     // 85
+    
+    assert(queue.getPendingCount() == 3);
+    assert(queue.peekNextPatient().getPatientID() == "P002");
+    assert(queue.getNextPatient().getPatientID() == "P002");
+    assert(queue.getNextPatient().getPatientID() == "P003");
+    assert(queue.getNextPatient().getPatientID() == "P001");
+    assert(queue.isEmpty());
+    assert(queue.getTotalProcessed() == 3);
+    
+    std::cout << "✓ Triage ordering test passed!\n";
+}
+
+void testPriorityUpdate() {
+    std::cout << "\n🧪 Testing In-Place Priority Updates...\n";
+    
+    TriageQueue queue;
+    for (int i = 0; i < 50; i++) {
+        queue.addPatient(Patient("P" + std::to_string(i), makeVitals(80, 120, 98), "ER"));
+    }
+    queue.addPatient(Patient("SICK", makeVitals(105, 120, 98), "ER"));
+    assert(queue.peekNextPatient().getPatientID() == "SICK");
+    
+    // Deteriorating patient moves to the front; recovering one moves back
+    queue.updatePatientPriority("P17", makeVitals(40, 80, 85));
+    assert(queue.peekNextPatient().getPatientID() == "P17");
+    assert(queue.peekNextPatient().getSeverityScore() == 10);
+    queue.updatePatientPriority("P17", makeVitals(80, 120, 98));
+    assert(queue.peekNextPatient().getPatientID() == "SICK");
+    assert(queue.getPendingCount() == 51);
+    
+    // Unknown patients are reported, not inserted
+    queue.updatePatientPriority("NOBODY", makeVitals(40, 80, 85));
+    assert(queue.getPendingCount() == 51);
+    assert(!queue.contains("NOBODY"));
+    
+    // Removal by ID, and the index follows extraction
+    assert(queue.removePatient("SICK"));
+    assert(!queue.removePatient("SICK"));
+    Patient next = queue.getNextPatient();
+    assert(!queue.contains(next.getPatientID()));
+    assert(queue.contains("P17"));
+    
+    // Re-adding a queued patient refreshes the entry instead of duplicating it
+    queue.addPatient(Patient("P17", makeVitals(40, 80, 85), "ICU_1"));
+    assert(queue.getPendingCount() == 49);
+    assert(queue.peekNextPatient().getPatientID() == "P17");
+    assert(queue.peekNextPatient().getLocation() == "ICU_1");
+    
+    std::cout << "✓ Priority update test passed!\n";
+}
+
+void testFifoTiesAndRecords() {
+    std::cout << "\n🧪 Testing FIFO Tie-Breaking and Compact Records...\n";
+    
+    // The heap moves 12-byte records, not Patient objects
+    assert(sizeof(TriageRecord) == 12);
+    assert(sizeof(Patient) >= 5 * sizeof(TriageRecord));
+    
+    TriageQueue queue;
+    queue.setVerbose(false);
+    for (int i = 0; i < 20; i++) {
+        queue.addPatient(Patient("T" + std::to_string(i), makeVitals(105, 120, 98), "ER"));
+    }
+    
+    // Equal severity is served strictly in arrival order
+    for (int i = 0; i < 10; i++) {
+        assert(queue.getNextPatient().getPatientID() == "T" + std::to_string(i));
+    }
+    
+    // Freed store slots are reused without disturbing the order of the rest
+    for (int i = 20; i < 30; i++) {
+        queue.addPatient(Patient("T" + std::to_string(i), makeVitals(105, 120, 98), "ER"));
+    }
+    queue.updatePatientPriority("T25", makeVitals(105, 120, 98));   // same score, keeps place
+    for (int i = 10; i < 30; i++) {
+        Patient next = queue.getNextPatient();
+        assert(next.getPatientID() == "T" + std::to_string(i));
+        assert(next.getSeverityScore() == 85);
+    }
+    assert(queue.isEmpty());
+    
+    std::cout << "✓ FIFO tie-breaking test passed!\n";
+}
+
+void testCriticalPatients() {
+    std::cout << "\n🧪 Testing Critical Patient Listing...\n";
+    
+    TriageQueue queue;
+    queue.addPatient(Patient("A", makeVitals(80, 120, 98), "ER"));
+    queue.addPatient(Patient("B", makeVitals(40, 80, 85), "ER"));
+    queue.addPatient(Patient("C", makeVitals(105, 120, 98), "ER"));
+    queue.addPatient(Patient("D", makeVitals(40, 120, 98), "ER"));
+    
+    std::vector<Patient> top = queue.getCriticalPatients(2);
+    assert(top.size() == 2);
+    assert(top[0].getPatientID() == "B");
+    assert(top[1].getPatientID() == "D");
+    assert(queue.getPendingCount() == 4);
+    
+    // Read-only: asking again (or for more than there are) changes nothing
+    const TriageQueue& view = queue;
+    std::vector<Patient> all = view.getCriticalPatients(10);
+    assert(all.size() == 4);
+    assert(all[0].getPatientID() == "B" && all[1].getPatientID() == "D");
+    assert(all[2].getPatientID() == "C" && all[3].getPatientID() == "A");
+    assert(view.getCriticalPatients(0).empty());
+    assert(queue.peekNextPatient().getPatientID() == "B");
+    queue.displayQueue(3);
+    
+    // The queue still works by ID afterwards
+    VitalSigns worst = makeVitals(40, 80, 80);
+    worst.temperature = 40.0;       // score 0
+    queue.updatePatientPriority("A", worst);
+    assert(queue.getNextPatient().getPatientID() == "A");
+    
+    std::cout << "✓ Critical patient test passed!\n";
+}
+
+void testSeverityBuckets() {
+    std::cout << "\n🧪 Testing Severity Bucket Queue...\n";
+    
+    SeverityBucketQueue buckets;
+    buckets.insert(0, 50);
+    buckets.insert(1, 100);
+    buckets.insert(2, 50);
+    buckets.insert(3, 0);
+    buckets.insert(7, 64);      // crosses into the second bitmap word
+    assert(buckets.size() == 5);
+    assert(buckets.getMin() == 3);
+    
+    // Walking in service order does not dequeue anything
+    uint32_t expected[] = {3, 0, 2, 7, 1};
+    uint32_t slot = buckets.getMin();
+    for (int i = 0; i < 5; i++) {
+        assert(slot == expected[i]);
+        slot = buckets.successor(slot);
+    }
+    assert(slot == SeverityBucketQueue::NONE);
+    
+    // Re-prioritising sends a slot to the back of its new bucket
+    buckets.update(0, 50);      // unchanged: keeps its place
+    buckets.update(3, 50);
+    assert(buckets.severityOf(3) == 50);
+    buckets.erase(7);
+    assert(!buckets.contains(7));
+    assert(buckets.extractMin() == 0);
+    assert(buckets.extractMin() == 2);
+    assert(buckets.extractMin() == 3);
+    assert(buckets.extractMin() == 1);
+    assert(buckets.isEmpty());
+    
+    bool threw = false;
+    try { buckets.insert(4, 101); } catch (const std::out_of_range&) { threw = true; }
+    assert(threw);
+    
+    // Both TriageQueue backends hand out patients in exactly the same order
+    TriageQueue heapQueue(TriageBackend::INDEXED_HEAP);
+    TriageQueue bucketQueue(TriageBackend::SEVERITY_BUCKETS);
+    heapQueue.setVerbose(false);
+    bucketQueue.setVerbose(false);
+    assert(bucketQueue.getBackend() == TriageBackend::SEVERITY_BUCKETS);
+    
+    std::srand(5);
+    for (int step = 0; step < 3000; step++) {
+        int op = std::rand() % 10;
+        std::string id = "P" + std::to_string(std::rand() % 300);
+        VitalSigns vitals = makeVitals(40 + std::rand() % 90, 80 + std::rand() % 90,
+                                       84 + std::rand() % 16);
+        if (op < 5) {
+            heapQueue.addPatient(Patient(id, vitals, "ER"));
+            bucketQueue.addPatient(Patient(id, vitals, "ER"));
+        } else if (op < 7 && heapQueue.contains(id)) {
+            heapQueue.updatePatientPriority(id, vitals);
+            bucketQueue.updatePatientPriority(id, vitals);
+        } else if (op < 8) {
+            assert(heapQueue.removePatient(id) == bucketQueue.removePatient(id));
+        } else if (!heapQueue.isEmpty()) {
+            assert(heapQueue.getNextPatient().getPatientID() == 
+                   bucketQueue.getNextPatient().getPatientID());
+        }
+        assert(heapQueue.getPendingCount() == bucketQueue.getPendingCount());
+    }
+    
+    std::vector<Patient> fromHeap = heapQueue.getCriticalPatients(25);
+    std::vector<Patient> fromBuckets = bucketQueue.getCriticalPatients(25);
+    assert(fromHeap.size() == fromBuckets.size());
+    for (size_t i = 0; i < fromHeap.size(); i++) {
+        assert(fromHeap[i].getPatientID() == fromBuckets[i].getPatientID());
+    }
+    while (!heapQueue.isEmpty()) {
+        assert(heapQueue.getNextPatient().getPatientID() == 
+               bucketQueue.getNextPatient().getPatientID());
+    }
+    assert(bucketQueue.isEmpty());
+    
+    std::cout << "✓ Severity bucket test passed!\n";
+}
+
+void testConcurrentIntake() {
+    std::cout << "\n🧪 Testing Concurrent Multi-Producer Intake...\n";
+    
+    // 8 desks and 4 consumers hammering the queue at once: every patient
+    // must come out exactly once
+    const int producers = 8;
+    const int perProducer = 4000;
+    ConcurrentTriageQueue queue(16);
+    std::atomic<int> producersDone(0);
+    std::vector<std::vector<std::string> > served(4);
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&queue, &producersDone, p, perProducer]() {
+            for (int i = 0; i < perProducer; i++) {
+                VitalSigns vitals = makeVitals(40 + (i * 7 + p) % 90, 80 + (i * 13) % 90, 
+                                               84 + (i + p) % 16);
+                queue.addPatient(Patient("D" + std::to_string(p) + "_" + std::to_string(i), 
+                                         vitals, "ER"));
+            }
+            producersDone++;
+        }));
+    }
+    for (int c = 0; c < 4; c++) {
+        threads.push_back(std::thread([&queue, &producersDone, &served, c, producers]() {
+            Patient patient;
+            while (true) {
+                if (queue.tryGetNextPatient(patient)) {
+                    served[c].push_back(patient.getPatientID());
+                } else if (producersDone.load() == producers && queue.isEmpty()) {
+                    break;
+                }
+            }
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    
+    std::set<std::string> seen;
+    size_t total = 0;
+    for (const std::vector<std::string>& ids : served) {
+        total += ids.size();
+        seen.insert(ids.begin(), ids.end());
+    }
+    assert(total == static_cast<size_t>(producers * perProducer));
+    assert(seen.size() == total);
+    assert(queue.getTotalProcessed() == producers * perProducer);
+    
+    // Relaxed order: measure the rank error of a quiescent drain against a
+    // strict reference. The mean must stay within the O(shards) bound.
+    ConcurrentTriageQueue relaxed(16);
+    std::multiset<int> waiting;
+    std::srand(11);
+    for (int i = 0; i < 5000; i++) {
+        VitalSigns vitals = makeVitals(40 + std::rand() % 90, 80 + std::rand() % 90, 
+                                       84 + std::rand() % 16);
+        Patient patient("R" + std::to_string(i), vitals, "ER");
+        relaxed.addPatient(patient);
+        waiting.insert(patient.getSeverityScore());
+    }
+    long long totalRankError = 0;
+    Patient patient;
+    while (relaxed.tryGetNextPatient(patient)) {
+        int severity = patient.getSeverityScore();
+        totalRankError += std::distance(waiting.begin(), waiting.lower_bound(severity));
+        waiting.erase(waiting.find(severity));
+    }
+    assert(waiting.empty());
+    assert(totalRankError / 5000 <= static_cast<long long>(relaxed.getShardCount()));
+    std::cout << "  Mean rank error over 16 shards: " << totalRankError / 5000.0 << "\n";
+    
+    std::cout << "✓ Concurrent intake test passed!\n";
+}
+
+void testAgingOrder() {
+    std::cout << "\n🧪 Testing Time-Aware Aging...\n";
+    
+    // Severity at time t is max(0, base - waited / 600s); the aging key must
+    // order patients exactly as a full re-score would, at any t
+    time_t now = std::time(nullptr);
+    TriageQueue queue;
+    queue.setVerbose(false);
+    queue.setAgingEnabled(true);
+    assert(queue.isAgingEnabled());
+    
+    std::srand(21);
+    std::vector<Patient> waiting;
+    for (int i = 0; i < 400; i++) {
+        VitalSigns vitals = makeVitals(40 + std::rand() % 90, 80 + std::rand() % 90,
+                                       84 + std::rand() % 16);
+        Patient patient("W" + std::to_string(i), vitals, "ER");
+        patient.setArrivalTime(now - (std::rand() % (24 * 3600)));    // up to a day ago
+        queue.addPatient(patient);
+        waiting.push_back(patient);
+    }
+    
+    // A long-waiting moderate patient overtakes a fresh, slightly sicker one
+    Patient veteran("VET", makeVitals(105, 120, 98), "ER");        // base 85
+    veteran.setArrivalTime(now - 200 * 60 * 10);                    // 200 points of waiting
+    Patient fresh("NEW", makeVitals(40, 80, 85), "ER");             // base 10
+    queue.addPatient(fresh);
+    queue.addPatient(veteran);
+    waiting.push_back(fresh);
+    waiting.push_back(veteran);
+    
+    // Compare against re-scoring everyone at a few later instants. The heap
+    // is never touched between checks, yet its order stays correct.
+    const time_t laters[] = {now, now + 3600, now + 5 * 24 * 3600};
+    for (time_t later : laters) {
+        std::vector<Patient> top = queue.getCriticalPatients(static_cast<int>(waiting.size()));
+        assert(top.size() == waiting.size());
+        for (size_t i = 1; i < top.size(); i++) {
+            assert(top[i - 1].calculateSeverityAt(later) <= top[i].calculateSeverityAt(later));
+        }
+    }
+    
+    std::vector<Patient> order = queue.getCriticalPatients(static_cast<int>(waiting.size()));
+    size_t veteranRank = 0, freshRank = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        if (order[i].getPatientID() == "VET") veteranRank = i;
+        if (order[i].getPatientID() == "NEW") freshRank = i;
+    }
+    assert(veteranRank < freshRank);
+    
+    // Priority changes keep the original arrival time; then drain in order
+    queue.updatePatientPriority("NEW", makeVitals(80, 120, 98));   // recovered: base 100
+    int previous = -1;
+    for (size_t i = 0; i < waiting.size(); i++) {
+        Patient next = queue.getNextPatient();
+        int severity = next.calculateSeverityAt(now);
+        assert(severity >= previous);
+        previous = severity;
+        assert(next.getSeverityScore() <= severity);    // refreshed when it left
+    }
+    assert(previous == 100);
+    assert(queue.isEmpty());
+    
+    // Aging needs the heap backend and an empty queue to switch
+    TriageQueue buckets(TriageBackend::SEVERITY_BUCKETS);
+    bool threw = false;
+    try { buckets.setAgingEnabled(true); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    
+    std::cout << "✓ Aging order test passed!\n";
+}
+
+void testBatchAdmission() {
+    std::cout << "\n🧪 Testing Batch Admission...\n";
+    
+    // A batch must leave the queue exactly as one-by-one admission would,
+    // including refreshes of queued patients and repeats inside the batch
+    const TriageBackend backends[] = {TriageBackend::INDEXED_HEAP, TriageBackend::SEVERITY_BUCKETS};
+    for (TriageBackend backend : backends) {
+        TriageQueue batched(backend);
+        TriageQueue sequential(backend);
+        batched.setVerbose(false);
+        sequential.setVerbose(false);
+        
+        std::srand(31);
+        for (int round = 0; round < 4; round++) {
+            std::vector<Patient> surge;
+            int size = (round == 1) ? 3 : 2000;     // small batches take the sift path
+            for (int i = 0; i < size; i++) {
+                VitalSigns vitals = makeVitals(40 + std::rand() % 90, 80 + std::rand() % 90,
+                                               84 + std::rand() % 16);
+                surge.push_back(Patient("B" + std::to_string(std::rand() % 3000), vitals, "ER"));
+            }
+            batched.addPatientsBatch(surge);
+            for (const Patient& patient : surge) {
+                sequential.addPatient(patient);
+            }
+            assert(batched.getPendingCount() == sequential.getPendingCount());
+            
+            for (int i = 0; i < 200 && !sequential.isEmpty(); i++) {
+                assert(batched.getNextPatient().getPatientID() == 
+                       sequential.getNextPatient().getPatientID());
+            }
+        }
+        while (!sequential.isEmpty()) {
+            assert(batched.getNextPatient().getPatientID() == 
+                   sequential.getNextPatient().getPatientID());
+        }
+        assert(batched.isEmpty());
+        
+        batched.addPatientsBatch(std::vector<Patient>());
+        assert(batched.isEmpty());
+    }
+    
+    std::cout << "✓ Batch admission test passed!\n";
+}
+
+void testBatchUndo() {
+    std::cout << "\n🧪 Testing Batch Admission Undo...\n";
+    
+    EmergencyResponseSystem system;
+    system.registerNewPatient(Patient("U001", makeVitals(130, 90, 88), "ER"));
+    system.registerNewPatient(Patient("U002", makeVitals(170, 60, 75), "ER"));
+    assert(system.processNextCriticalPatient().getPatientID() == "U002");
+    int registered = system.getTotalPatientsRegistered();
+    int pending = system.getPendingPatients();
+    
+    // Undo restores every patient the batch re-registered, even twice,
+    // and only a patient that was waiting goes back into triage
+    std::vector<Patient> surge;
+    surge.push_back(Patient("U001", makeVitals(60, 110, 97), "WARD"));
+    surge.push_back(Patient("U002", makeVitals(150, 70, 85), "ICU_1"));
+    surge.push_back(Patient("U003", makeVitals(90, 120, 95), "ER"));
+    surge.push_back(Patient("U001", makeVitals(70, 115, 96), "ICU_2"));
+    system.registerPatientsBatch(surge);
+    assert(system.getTotalPatientsRegistered() == registered + 3);
+    assert(system.getPendingPatients() == pending + 2);
+    system.undoLastOperation();
+    assert(system.getTotalPatientsRegistered() == registered);
+    assert(system.getPendingPatients() == pending);
+    Patient waiting = system.processNextCriticalPatient();
+    assert(waiting.getPatientID() == "U001");
+    assert(waiting.getLocation() == "ER" && waiting.getVitalSigns().heartRate == 130);
+    assert(system.getPendingPatients() == 0);
+    
+    std::cout << "✓ Batch admission undo test passed!\n";
+}
+
+static std::vector<std::string> drainIDs(TriageQueue queue) {
+    std::vector<std::string> ids;
+    queue.setVerbose(false);
+    while (!queue.isEmpty()) {
+        ids.push_back(queue.getNextPatient().getPatientID());
+    }
+    return ids;
+}
+
+void testQueueMerge() {
+    std::cout << "\n🧪 Testing Department Queue Merging...\n";
+    
+    // Every backend pairing: the merged queue serves both waiting lists
+    // interleaved by severity, ours first on ties, each in its own order
+    const TriageBackend backends[] = {TriageBackend::INDEXED_HEAP, TriageBackend::SEVERITY_BUCKETS,
+                                      TriageBackend::PAIRING_HEAP};
+    std::srand(41);
+    for (TriageBackend into : backends) {
+        for (TriageBackend from : backends) {
+            TriageQueue er(into);
+            TriageQueue trauma(from);
+            er.setVerbose(false);
+            trauma.setVerbose(false);
+            for (int i = 0; i < 300; i++) {
+                TriageQueue& target = (i % 3 == 0) ? trauma : er;
+                VitalSigns vitals = makeVitals(40 + std::rand() % 90, 80 + std::rand() % 90,
+                                               84 + std::rand() % 16);
+                target.addPatient(Patient("M" + std::to_string(i), vitals, "ER"));
+            }
+            er.getNextPatient();            // leave free slots and handles behind
+            trauma.removePatient("M3");
+            
+            std::vector<std::string> ours = drainIDs(er);
+            std::vector<std::string> theirs = drainIDs(trauma);
+            std::vector<int> ourSeverity, theirSeverity;
+            for (const Patient& p : er.getCriticalPatients(1000)) ourSeverity.push_back(p.getSeverityScore());
+            for (const Patient& p : trauma.getCriticalPatients(1000)) theirSeverity.push_back(p.getSeverityScore());
+            
+            std::vector<std::string> expected;
+            size_t a = 0, b = 0;
+            while (a < ours.size() || b < theirs.size()) {
+                if (b == theirs.size() || (a < ours.size() && ourSeverity[a] <= theirSeverity[b])) {
+                    expected.push_back(ours[a++]);
+                } else {
+                    expected.push_back(theirs[b++]);
+                }
+            }
+            
+            er.mergeFrom(std::move(trauma));
+            assert(trauma.isEmpty());
+            assert(er.getPendingCount() == static_cast<int>(expected.size()));
+            assert(er.contains("M0") && !er.contains("M3"));
+            
+            // Both queues stay fully usable afterwards
+            er.updatePatientPriority("M6", makeVitals(80, 120, 98));
+            std::vector<std::string> merged = drainIDs(er);
+            expected.erase(std::find(expected.begin(), expected.end(), "M6"));
+            merged.erase(std::find(merged.begin(), merged.end(), "M6"));
+            assert(merged == expected);
+            trauma.addPatient(Patient("AFTER", makeVitals(80, 120, 98), "ER"));
+            assert(trauma.getNextPatient().getPatientID() == "AFTER");
+        }
+    }
+    
+    // A patient on both lists stays queued once, refreshed from the other list
+    TriageQueue left(TriageBackend::PAIRING_HEAP);
+    TriageQueue right(TriageBackend::PAIRING_HEAP);
+    left.setVerbose(false);
+    right.setVerbose(false);
+    left.addPatient(Patient("SHARED", makeVitals(80, 120, 98), "ER"));
+    left.addPatient(Patient("L1", makeVitals(105, 120, 98), "ER"));
+    right.addPatient(Patient("SHARED", makeVitals(40, 80, 85), "TRAUMA"));
+    right.addPatient(Patient("R1", makeVitals(80, 120, 98), "TRAUMA"));
+    left.mergeFrom(std::move(right));
+    assert(left.getPendingCount() == 3);
+    assert(left.peekNextPatient().getPatientID() == "SHARED");
+    assert(left.peekNextPatient().getLocation() == "TRAUMA");
+    
+    // Aging keys are only comparable between aging queues
+    TriageQueue aging;
+    aging.setAgingEnabled(true);
+    bool threw = false;
+    try { aging.mergeFrom(std::move(left)); } catch (const std::runtime_error&) { threw = true; }
+    assert(threw);
+    
+    std::cout << "✓ Queue merge test passed!\n";
+}
+
+void testFixedIds() {
+    std::cout << "\n🧪 Testing Fixed-Width IDs...\n";
+    
+    PatientId empty;
+    assert(empty.empty() && empty.size() == 0 && empty == "");
+    
+    PatientId id("P042");
+    assert(id.size() == 4 && id == "P042" && id == std::string("P042"));
+    assert(id != "P04" && id != "P0420");
+    assert(PatientId(std::string(31, 'x')).size() == 31);
+    bool rejected = false;
+    try {
+        PatientId tooLong(std::string(32, 'x'));
+    } catch (const std::length_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    // Ordering and hashing agree with the strings they replace
+    std::vector<std::string> names = {"P10", "P1", "P2", "A", "P100", "B9"};
+    for (const std::string& a : names) {
+        for (const std::string& b : names) {
+            assert((PatientId(a) < PatientId(b)) == (a < b));
+            assert((PatientId(a) == PatientId(b)) == (a == b));
+        }
+    }
+    assert(std::hash<PatientId>()("P1") == std::hash<PatientId>()(std::string("P1")));
+    
+    // Getters hand out references to inline storage
+    Patient patient("P777", makeVitals(80, 120, 98), "ER");
+    assert(&patient.getPatientID() == &patient.getPatientID());
+    assert(patient.getLocation() == "ER");
+    assert(LocationId(PatientId("ER")) == patient.getLocation());
+    
+    std::cout << "✓ Fixed-width ID tests passed!\n";
+}
+
+void testFlatHashMap() {
+    std::cout << "\n🧪 Testing Flat Hash Map...\n";
+    
+    // Random inserts, overwrites and erases agree with std::map
+    FlatHashMap<int, int> flat;
+    std::map<int, int> reference;
+    std::srand(7);
+    for (int i = 0; i < 200000; i++) {
+        int key = std::rand() % 3000;
+        switch (std::rand() % 4) {
+            case 0:
+                flat[key] = i;
+                reference[key] = i;
+                break;
+            case 1:
+                assert(flat.erase(key) == reference.erase(key));
+                break;
+            case 2: {
+                bool added = flat.insert(std::make_pair(key, i)).second;
+                assert(added == reference.insert(std::make_pair(key, i)).second);
+                break;
+            }
+            default: {
+                auto it = flat.find(key);
+                auto expected = reference.find(key);
+                assert((it == flat.end()) == (expected == reference.end()));
+                if (it != flat.end()) assert(it->second == expected->second);
+            }
+        }
+        assert(flat.size() == reference.size());
+    }
+    
+    // Iteration visits every entry once; copies are independent
+    size_t visited = 0;
+    for (const auto& entry : flat) {
+        assert(reference.at(entry.first) == entry.second);
+        visited++;
+    }
+    assert(visited == reference.size());
+    FlatHashMap<int, int> copy(flat);
+    copy.clear();
+    assert(copy.empty() && copy.begin() == copy.end() && flat.size() == reference.size());
+    
+    // Erase-heavy churn reuses DELETED slots instead of growing forever
+    FlatHashMap<PatientId, uint32_t> ids;
+    ids.reserve(1000);
+    size_t buckets = ids.bucket_count();
+    for (uint32_t i = 0; i < 100000; i++) {
+        ids["C" + std::to_string(i)] = i;
+        if (i >= 500) assert(ids.erase("C" + std::to_string(i - 500)) == 1);
+    }
+    assert(ids.size() == 500 && ids.bucket_count() == buckets);
+    assert(ids.count("C99999") == 1 && ids.count("C0") == 0);
+    for (uint32_t i = 99500; i < 100000; i++) {
+        assert(ids.find("C" + std::to_string(i))->second == i);
+    }
+    
+    std::cout << "✓ Flat hash map tests passed!\n";
+}
+
+void testColumnarScoring() {
+    std::cout << "\n🧪 Testing Columnar Severity Scoring...\n";
+    
+    // Every threshold edge, NaN, and waits around each cutoff of the clamp
+    const int heartRates[] = {INT_MIN, 0, 49, 50, 59, 60, 80, 100, 101, 120, 121, INT_MAX};
+    const int pressures[] = {-5, 89, 90, 99, 100, 140, 141, 160, 161};
+    const int oxygen[] = {0, 89, 90, 94, 95, 100};
+    const double temperatures[] = {34.999, 35.0, 37.0, 39.0, 39.0001, std::nan("")};
+    const long long waits[] = {-(1LL << 40), -(1LL << 32), -1, 0, 599, 600, 601, 60000, 119999, 120000,
+                               120001, (1LL << 31) + 7, (1LL << 32) + 5, 100000000000LL};
+    const time_t now = 1700000000;
+    
+    PatientColumns columns;
+    std::vector<int32_t> expected;
+    for (int heart : heartRates) {
+        for (int pressure : pressures) {
+            for (int level : oxygen) {
+                for (double temperature : temperatures) {
+                    for (long long wait : waits) {
+                        VitalSigns vitals = makeVitals(heart, pressure, level);
+                        vitals.temperature = temperature;
+                        Patient patient("COL", vitals, "ER");
+                        patient.setArrivalTime(static_cast<time_t>(now - wait));
+                        columns.append(patient);
+                        expected.push_back(patient.calculateSeverityAt(now));
+                    }
+                }
+            }
+        }
+    }
+    // Every wait up to the clamp, to cover the divide-by-600 trick exhaustively
+    for (int wait = 0; wait <= 121000; wait++) {
+        Patient patient("COL", makeVitals(80, 120, 98), "ER");
+        patient.setArrivalTime(now - wait);
+        columns.append(patient);
+        expected.push_back(patient.calculateSeverityAt(now));
+    }
+    
+    const ScoringPath paths[] = {ScoringPath::SCALAR, ScoringPath::SSE2, ScoringPath::AVX2};
+    for (ScoringPath path : paths) {
+        if (!PatientColumns::isSupported(path)) continue;
+        std::vector<int32_t> scores(columns.size(), -1);
+        columns.scoreRange(0, columns.size(), now, scores.data(), path);
+        assert(scores == expected);
+        
+        // Unaligned start and a ragged tail
+        std::vector<int32_t> middle(columns.size() - 8, -1);
+        columns.scoreRange(3, middle.size(), now, middle.data(), path);
+        assert(std::equal(middle.begin(), middle.end(), expected.begin() + 3));
+        std::cout << "  " << PatientColumns::pathName(path) << " matches calculateSeverityAt\n";
+    }
+    assert(PatientColumns::isSupported(PatientColumns::bestPath()));
+    
+    // Rows can be edited in place
+    columns.setVitals(0, makeVitals(80, 120, 98));
+    columns.setArrivalTime(0, now);
+    int32_t first = -1;
+    columns.scoreRange(0, 1, now, &first);
+    assert(first == 100);
+    
+    bool rejected = false;
+    try {
+        columns.scoreRange(columns.size() - 2, 3, now, &first);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    std::cout << "✓ Columnar scoring tests passed!\n";
+}
+
+void testUndoJournal() {
+    std::cout << "\n🧪 Testing Undo Journal...\n";
+    
+    assert(sizeof(UndoEntry) == 16);
+    UndoJournal journal(4);
+    
+    // Vitals deltas round-trip exactly, in range or spilled
+    VitalSigns before = makeVitals(72, 118, 97);
+    before.temperature = 36.6;
+    VitalSigns after = makeVitals(135, 85, 84);
+    after.temperature = 39.4;
+    journal.recordVitalsChange("P1", before, after);
+    assert(!(journal.top().flags & UndoEntry::SPILLED));
+    VitalSigns restored = journal.previousVitals(journal.top(), after);
+    assert(restored.heartRate == 72 && restored.bloodPressure == 118 && restored.oxygenLevel == 97);
+    assert(restored.temperature == 36.6);
+    
+    VitalSigns odd = before;
+    odd.temperature = 36.6125;
+    journal.recordVitalsChange("P1", odd, after);
+    assert(journal.top().flags & UndoEntry::SPILLED);
+    assert(journal.previousVitals(journal.top(), after).temperature == 36.6125);
+    journal.pop();
+    journal.pop();
+    assert(journal.isEmpty());
+    
+    // Interned symbols and the static description table
+    journal.recordTransfer("P2", "ER", "ICU_1");
+    assert(journal.symbol(journal.top().payload.move.from) == "ER");
+    assert(journal.symbol(journal.top().payload.move.to) == "ICU_1");
+    assert(UndoJournal::getDescription(OperationType::PATIENT_TRANSFERRED) == "Patient moved to a new location");
+    
+    MedicalStaff doctor("DR1", "Dr. Test", StaffRole::DOCTOR);
+    journal.recordStaffAssignment("P2", doctor);
+    assert(journal.top().payload.staff.previousPatient == UndoJournal::NO_SYMBOL);
+    assert(journal.symbol(journal.top().payload.staff.staff) == "DR1");
+    
+    // Eviction releases the side storage of the entries that fall off
+    std::vector<PatientId> ids;
+    for (int i = 0; i < 50; i++) ids.push_back("B" + std::to_string(i));
+    for (int round = 0; round < 10; round++) {
+        journal.recordBatchRegistration(ids, std::vector<ReplacedRegistration>());
+    }
+    assert(journal.size() == 4);
+    std::vector<PatientId> batch = journal.batchPatientIDs(journal.top());
+    assert(batch.size() == 50 && batch.front() == "B0" && batch.back() == "B49");
+    while (!journal.isEmpty()) {
+        journal.pop();
+    }
+    assert(journal.symbolCount() == 0);
+    
+    // Symbols go with the last entry naming them, so churn does not grow the table
+    for (int i = 0; i < 1000; i++) {
+        journal.recordTransfer("T" + std::to_string(i), "ER", "WARD_" + std::to_string(i % 7));
+    }
+    assert(journal.symbolCount() <= 4 * 2 + 2);
+    assert(journal.symbol(journal.top().subject) == "T999");
+    assert(journal.symbol(journal.top().payload.move.from) == "ER");
+    
+    std::cout << "✓ Undo journal tests passed!\n";
+}
+
+void testUndoRollback() {
+    std::cout << "\n🧪 Testing Undo Rollback...\n";
+    
+    EmergencyResponseSystem system;
+    Patient patient("U001", makeVitals(130, 90, 88), "ER");
+    system.registerNewPatient(patient);
+    assert(system.isPatientWaiting("U001"));
+    int severity = system.findPatient("U001")->getSeverityScore();
+    
+    // Each operation is rolled back in reverse order
+    system.updatePatientVitals("U001", makeVitals(80, 120, 98));
+    system.transferPatient("U001", "ICU_1");
+    system.assignStaffToPatient("DR001", "U001");
+    assert(system.findStaff("DR001")->getAssignedPatientID() == "U001");
+    Patient treated = system.processNextCriticalPatient();
+    assert(treated.getPatientID() == "U001" && treated.getLocation() == "ICU_1");
+    assert(!system.isPatientWaiting("U001"));
+    
+    system.undoLastOperation();     // treatment
+    assert(system.isPatientWaiting("U001"));
+    assert(system.findPatient("U001")->getStatus() == TriageStatus::PENDING);
+    system.undoLastOperation();     // staff assignment
+    assert(system.findStaff("DR001")->getAssignedPatientID().empty());
+    assert(system.findStaff("DR001")->getStatus() == AvailabilityStatus::AVAILABLE);
+    assert(system.getTotalStaffAssignments() == 0);
+    system.undoLastOperation();     // transfer
+    assert(system.findPatient("U001")->getLocation() == "ER");
+    system.undoLastOperation();     // vitals
+    assert(system.findPatient("U001")->getVitalSigns().heartRate == 130);
+    assert(system.findPatient("U001")->getSeverityScore() == severity);
+    system.undoLastOperation();     // registration
+    assert(system.findPatient("U001") == nullptr);
+    assert(!system.isPatientWaiting("U001"));
+    assert(!system.canUndo());
+    
+    // Re-registration restores the record it replaced
+    system.registerNewPatient(patient);
+    system.registerNewPatient(Patient("U001", makeVitals(80, 120, 98), "WARD"));
+    system.undoLastOperation();
+    assert(system.findPatient("U001")->getLocation() == "ER");
+    assert(system.isPatientWaiting("U001"));
+    
+    // So does a batch, for every patient it re-registered, even twice
+    system.registerNewPatient(Patient("U002", makeVitals(170, 60, 75), "ER"));
+    assert(system.processNextCriticalPatient().getPatientID() == "U002");
+    int registered = system.getTotalPatientsRegistered();
+    std::vector<Patient> surge;
+    surge.push_back(Patient("U001", makeVitals(60, 110, 97), "WARD"));
+    surge.push_back(Patient("U002", makeVitals(150, 70, 85), "ICU_1"));
+    surge.push_back(Patient("U003", makeVitals(90, 120, 95), "ER"));
+    surge.push_back(Patient("U001", makeVitals(70, 115, 96), "ICU_2"));
+    system.registerPatientsBatch(surge);
+    assert(system.getTotalPatientsRegistered() == registered + 3);
+    assert(system.isPatientWaiting("U002"));
+    system.undoLastOperation();
+    assert(system.getTotalPatientsRegistered() == registered);
+    assert(system.findPatient("U003") == nullptr);
+    assert(system.findPatient("U002")->getLocation() == "ER");
+    assert(!system.isPatientWaiting("U002"));
+    assert(system.findPatient("U001")->getLocation() == "ER");
+    assert(system.findPatient("U001")->getVitalSigns().heartRate == 130);
+    
+    std::cout << "✓ Undo rollback tests passed!\n";
+}
+
+void testWriteAheadLog() {
+    std::cout << "\n🧪 Testing Write-Ahead Log...\n";
+    
+    const std::string path = "test_journal.wal";
+    std::remove(path.c_str());
+    
+    // Records come back in order, with their payloads intact
+    {
+        WriteAheadLog log(path, 0, 500);
+        for (int i = 0; i < 1000; i++) {
+            RecordWriter record;
+            record.putI32(i);
+            record.putString("P" + std::to_string(i));
+            record.putDouble(36.5 + i / 100.0);
+            log.append(static_cast<uint8_t>(1 + i % 3), record);
+        }
+        log.sync();
+        assert(log.getRecordCount() == 1000);
+        assert(log.getCommitCount() >= 1);
+    }
+    uint64_t end = 0;
+    int expected = 0;
+    uint64_t validLength = WriteAheadLog::replay(path, 0, [&expected](uint8_t type, RecordReader& payload) {
+        assert(type == 1 + expected % 3);
+        assert(payload.getI32() == expected);
+        assert(payload.getString() == "P" + std::to_string(expected));
+        assert(payload.getDouble() == 36.5 + expected / 100.0);
+        expected++;
+    }, end);
+    assert(end == 1000 && expected == 1000);
+    
+    // A torn tail is ignored on replay and cut off when the log reopens
+    {
+        std::ofstream file(path.c_str(), std::ios::binary | std::ios::app);
+        file.write("\x40\x00\x00\x00\x12\x34", 6);
+    }
+    assert(WriteAheadLog::replay(path, 0, [](uint8_t, RecordReader&) {}, end) == validLength);
+    assert(end == 1000);
+    {
+        WriteAheadLog log(path, validLength, 500, end);
+        RecordWriter record;
+        record.putI32(1000);
+        record.putString("P1000");
+        record.putDouble(0.0);
+        log.append(1, record);
+    }
+    WriteAheadLog::replay(path, 0, [](uint8_t, RecordReader&) {}, end);
+    assert(end == 1001);
+    
+    // A flipped bit fails the checksum; replay stops before that record
+    {
+        std::fstream file(path.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(validLength) - 3);
+        file.put('\x7f');
+    }
+    WriteAheadLog::replay(path, 0, [](uint8_t, RecordReader&) {}, end);
+    assert(end == 999);
+    
+    // Discarding keeps later records at their positions and drops the rest
+    std::remove(path.c_str());
+    {
+        WriteAheadLog log(path, 0, 500);
+        for (int i = 0; i < 300; i++) {
+            RecordWriter record;
+            record.putI32(i);
+            log.append(1, record);
+        }
+        WriteAheadLog::Mark mark = log.mark();
+        assert(mark.position == 300);
+        for (int i = 300; i < 350; i++) {
+            RecordWriter record;
+            record.putI32(i);
+            log.append(1, record);
+        }
+        log.discardBefore(mark);
+        log.sync();
+        
+        RecordWriter record;
+        record.putI32(350);
+        log.append(1, record);
+    }
+    expected = 300;
+    WriteAheadLog::replay(path, 300, [&expected](uint8_t, RecordReader& payload) {
+        assert(payload.getI32() == expected);
+        expected++;
+    }, end);
+    assert(end == 351 && expected == 351);
+    bool rejected = false;
+    try {
+        WriteAheadLog::replay(path, 0, [](uint8_t, RecordReader&) {}, end);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    std::remove(path.c_str());
+    std::cout << "✓ Write-ahead log tests passed!\n";
+}
+
+static void runJournaledOperations(EmergencyResponseSystem& system) {
+    std::vector<Patient> batch;
+    for (int i = 0; i < 20; i++) {
+        batch.push_back(Patient("R" + std::to_string(100 + i), 
+                                makeVitals(60 + 4 * i, 140 - 3 * i, 99 - i / 2), "ER"));
+    }
+    system.registerPatientsBatch(batch);
+    system.registerNewPatient(Patient("R200", makeVitals(150, 80, 82), "ER"));
+    system.registerNewPatient(Patient("R201", makeVitals(75, 120, 98), "ER"));
+    system.undoLastOperation();
+    system.updatePatientVitals("R105", makeVitals(140, 85, 85));
+    system.transferPatient("R110", "ICU_1");
+    system.assignStaffToPatient("DR001", "R200");
+    system.processNextCriticalPatient();
+    system.processNextCriticalPatient();
+}
+
+void testJournalRecovery() {
+    std::cout << "\n🧪 Testing Journal Recovery...\n";
+    
+    const std::string path = "test_recovery.wal";
+    const std::string crashCopy = "test_recovery_copy.wal";
+    std::remove(path.c_str());
+    
+    EmergencyResponseSystem live;
+    assert(live.openJournal(path) == 0);
+    runJournaledOperations(live);
+    live.closeCorridor("ER", "ICU_1");
+    live.closeCorridor("ICU_1", "OR_1");
+    live.reopenCorridor("ICU_1", "OR_1");
+    // Neither a missing corridor nor a repeated change is journaled
+    assert(!live.closeCorridor("ER", "OR_2"));
+    assert(live.closeCorridor("ER", "ICU_1"));
+    assert(live.reopenCorridor("ICU_1", "OR_1"));
+    live.syncJournal();
+    
+    // What a crash right now would leave on disk
+    {
+        std::ifstream source(path.c_str(), std::ios::binary);
+        std::ofstream copy(crashCopy.c_str(), std::ios::binary | std::ios::trunc);
+        copy << source.rdbuf();
+    }
+    
+    EmergencyResponseSystem recovered;
+    assert(recovered.openJournal(crashCopy) == 12);
+    assert(recovered.findPatient("R201") == nullptr);
+    assert(recovered.findPatient("R105")->getVitalSigns().heartRate == 140);
+    assert(recovered.findPatient("R110")->getLocation() == "ICU_1");
+    assert(recovered.findStaff("DR001")->getAssignedPatientID() == "R200");
+    assert(recovered.getTotalPatientsRegistered() == live.getTotalPatientsRegistered());
+    assert(recovered.getPendingPatients() == live.getPendingPatients());
+    assert(recovered.getTotalPatientsProcessed() == live.getTotalPatientsProcessed());
+    assert(recovered.getTotalPatientsProcessed() > 0);
+    
+    // Corridor closures replay too, reopenings included
+    assert(recovered.findFastestRoute("ER", "ICU_1").totalDistance > 12.0);
+    assert(recovered.findFastestRoute("ER", "ICU_1").totalDistance == 
+           live.findFastestRoute("ER", "ICU_1").totalDistance);
+    assert(recovered.findFastestRoute("ICU_1", "OR_1").totalDistance == 11.0);
+    
+    // Undo history survives too: the last treatment can be rolled back
+    recovered.undoLastOperation();
+    live.undoLastOperation();
+    
+    // Both serve the waiting list in the same order
+    while (live.getPendingPatients() > 0) {
+        assert(recovered.getPendingPatients() > 0);
+        assert(live.processNextCriticalPatient().getPatientID() == 
+               recovered.processNextCriticalPatient().getPatientID());
+    }
+    assert(recovered.getPendingPatients() == 0);
+    
+    std::remove(path.c_str());
+    std::remove(crashCopy.c_str());
+    std::cout << "✓ Journal recovery tests passed!\n";
+}
+
+void testSnapshot() {
+    std::cout << "\n🧪 Testing Snapshots...\n";
+    
+    const std::string journalPath = "test_snapshot.wal";
+    const std::string crashCopy = "test_snapshot_copy.wal";
+    const std::string snapshotPath = "test_snapshot.snap";
+    std::remove(journalPath.c_str());
+    
+    EmergencyResponseSystem live;
+    live.openJournal(journalPath);
+    runJournaledOperations(live);
+    live.closeCorridor("ER", "ICU_1");
+    int pendingAtSnapshot = live.getPendingPatients();
+    int registeredAtSnapshot = live.getTotalPatientsRegistered();
+    int processedAtSnapshot = live.getTotalPatientsProcessed();
+    int heartRateAtSnapshot = live.findPatient("R106")->getVitalSigns().heartRate;
+    
+    // Saving keeps the undo history
+    size_t undoDepth = 0;
+    assert(live.saveSnapshot(snapshotPath) > 0);
+    assert(live.canUndo());
+    live.waitForSnapshot();
+    
+    // Once the snapshot is on disk the journal starts over from it
+    live.syncJournal();
+    {
+        std::ifstream journal(journalPath.c_str(), std::ios::binary | std::ios::ate);
+        assert(static_cast<size_t>(journal.tellg()) == WriteAheadLog::HEADER_SIZE);
+    }
+    
+    // Operations after the snapshot live only in the journal. The third undo
+    // reaches back past the snapshot to the last treatment.
+    live.registerNewPatient(Patient("R300", makeVitals(145, 82, 84), "ER"));
+    live.updatePatientVitals("R106", makeVitals(135, 90, 86));
+    live.undoLastOperation();
+    live.undoLastOperation();
+    live.undoLastOperation();
+    assert(live.getPendingPatients() == pendingAtSnapshot + 1);
+    live.syncJournal();
+    {
+        std::ifstream source(journalPath.c_str(), std::ios::binary);
+        std::ofstream copy(crashCopy.c_str(), std::ios::binary | std::ios::trunc);
+        copy << source.rdbuf();
+    }
+    
+    // Without the snapshot the journal is refused: its start is gone
+    {
+        EmergencyResponseSystem cold;
+        bool refused = false;
+        try {
+            cold.openJournal(crashCopy);
+        } catch (const std::runtime_error&) {
+            refused = true;
+        }
+        assert(refused);
+    }
+    
+    EmergencyResponseSystem restored;
+    restored.loadSnapshot(snapshotPath);
+    assert(restored.getPendingPatients() == pendingAtSnapshot);
+    assert(restored.findPatient("R300") == nullptr);
+    assert(restored.findPatient("R105")->getVitalSigns().heartRate == 140);
+    assert(restored.findPatient("R110")->getLocation() == "ICU_1");
+    assert(restored.findStaff("DR001")->getAssignedPatientID() == "R200");
+    assert(restored.getTotalPatientsRegistered() == registeredAtSnapshot);
+    assert(restored.getTotalPatientsProcessed() == processedAtSnapshot && processedAtSnapshot > 0);
+    assert(restored.canUndo());
+    
+    // The closed corridor stays closed
+    assert(restored.findFastestRoute("ER", "ICU_1").totalDistance == 
+           live.findFastestRoute("ER", "ICU_1").totalDistance);
+    assert(restored.findFastestRoute("ER", "ICU_1").totalDistance > 12.0);
+    
+    // The journal replays only what came after the snapshot, and its undo
+    // records land on the history the snapshot carried
+    assert(restored.openJournal(crashCopy) == 5);
+    assert(restored.findPatient("R300") == nullptr);
+    assert(restored.findPatient("R106")->getVitalSigns().heartRate == heartRateAtSnapshot);
+    assert(restored.getTotalPatientsRegistered() == live.getTotalPatientsRegistered());
+    assert(restored.getPendingPatients() == live.getPendingPatients());
+    assert(restored.getTotalPatientsProcessed() == live.getTotalPatientsProcessed());
+    
+    // Same undo history all the way back, same waiting order
+    while (live.canUndo()) {
+        assert(restored.canUndo());
+        restored.undoLastOperation();
+        live.undoLastOperation();
+        undoDepth++;
+    }
+    assert(!restored.canUndo() && undoDepth > 0);
+    assert(restored.getTotalPatientsRegistered() == live.getTotalPatientsRegistered());
+    assert(restored.findStaff("DR001")->getAssignedPatientID().empty());
+    while (live.getPendingPatients() > 0) {
+        assert(restored.getPendingPatients() > 0);
+        assert(live.processNextCriticalPatient().getPatientID() == 
+               restored.processNextCriticalPatient().getPatientID());
+    }
+    assert(restored.getPendingPatients() == 0);
+    
+    // Loading replaces journaled state only before the journal is open
+    bool rejected = false;
+    try {
+        restored.loadSnapshot(snapshotPath);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    // A damaged file is refused and leaves the system as it was
+    {
+        std::fstream file(snapshotPath.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x7f');
+    }
+    EmergencyResponseSystem fresh;
+    int pendingBefore = fresh.getPendingPatients();
+    rejected = false;
+    try {
+        fresh.loadSnapshot(snapshotPath);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    assert(fresh.getPendingPatients() == pendingBefore);
+    assert(fresh.findStaff("DR001")->getAssignedPatientID().empty());
+    
+    std::remove(journalPath.c_str());
+    std::remove(crashCopy.c_str());
+    std::remove(snapshotPath.c_str());
+    std::cout << "✓ Snapshot tests passed!\n";
+}
+
+// Swallows console output without touching the heap
+struct DiscardBuffer : std::streambuf {
+    int overflow(int c) { return c; }
+};
+
+void testAllocationFreeIntake() {
+    std::cout << "\n🧪 Testing Allocation-Free Intake...\n";
+    
+    const std::string journalPath = "test_intake.wal";
+    std::remove(journalPath.c_str());
+    
+    // Each cycle leaves three undo entries; warm up until the undo ring has
+    // wrapped so every buffer on the path has reached its working size
+    EmergencyResponseSystem system;
+    const int warmUp = static_cast<int>(system.getUndoDepth() / 3) + 1000;
+    const int measured = 4000;
+    std::vector<Patient> arrivals;
+    for (int i = 0; i < warmUp + measured; i++) {
+        arrivals.push_back(Patient("A" + std::to_string(100000 + i), 
+                                   makeVitals(60 + i % 90, 80 + i % 70, 85 + i % 15), "ER"));
+    }
+    system.reservePatientCapacity(arrivals.size());
+    system.openJournal(journalPath);
+    
+    // Then journaled register -> triage -> staff dispatch must not allocate
+    DiscardBuffer discard;
+    std::streambuf* console = std::cout.rdbuf(&discard);
+    for (int i = 0; i < warmUp; i++) {
+        system.registerNewPatient(arrivals[i]);
+        system.assignStaffToPatient("DR001", system.processNextCriticalPatient().getPatientID());
+    }
+    
+    size_t before = allocationCount();
+    for (int i = warmUp; i < warmUp + measured; i++) {
+        system.registerNewPatient(arrivals[i]);
+        system.assignStaffToPatient("DR001", system.processNextCriticalPatient().getPatientID());
+    }
+    size_t allocations = allocationCount() - before;
+    std::cout.rdbuf(console);
+    
+    std::cout << "  Allocations over " << measured << " register + dispatch cycles: " << allocations << "\n";
+    assert(allocations == 0);
+    assert(system.getTotalStaffAssignments() == warmUp + measured);
+    
+    // Dispatch routes from a mapped room come out of the route cache into
+    // the caller's RouteInfo without reallocating its path
+    Graph layout;
+    layout.addNode("ER", Coordinates(0, 0));
+    layout.addNode("ICU", Coordinates(10, 0));
+    layout.addNode("OR", Coordinates(20, 0));
+    layout.addBidirectionalEdge("ER", "ICU", 10);
+    layout.addBidirectionalEdge("ICU", "OR", 10);
+    DijkstraRouter router(&layout);
+    RouteInfo route;
+    router.findShortestPath("ER", "OR", route);
+    before = allocationCount();
+    for (int i = 0; i < 1000; i++) {
+        router.findShortestPath("ER", "OR", route);
+    }
+    assert(allocationCount() == before);
+    assert(route.path.size() == 3 && route.totalDistance == 20.0);
+    
+    std::remove(journalPath.c_str());
+    std::cout << "✓ Allocation-free intake test passed!\n";
+}
+
+int main() {
+    std::cout << "╔══════════════════════════════════════╗\n";
+    std::cout << "║   TRIAGE QUEUE UNIT TESTS            ║\n";
+    std::cout << "╚══════════════════════════════════════╝\n";
+    
+    testTriageOrdering();
+    testPriorityUpdate();
+    testFifoTiesAndRecords();
+    testCriticalPatients();
+    testSeverityBuckets();
+    testConcurrentIntake();
+    testAgingOrder();
+    testBatchAdmission();
+    testBatchUndo();
+    testQueueMerge();
+    testFixedIds();
+    testFlatHashMap();
+    testColumnarScoring();
+    testUndoJournal();
+    testUndoRollback();
+    testWriteAheadLog();
+    testJournalRecovery();
+    testSnapshot();
+    testAllocationFreeIntake();
+    
+    std::cout << "\n✅ All Triage Queue tests passed!\n\n";
+    return 0;
+}